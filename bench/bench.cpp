@@ -0,0 +1,369 @@
+/*
+Jakub Janeczko
+mikrobenchmarki gorących ścieżek silnika fizyki
+18.10.2026
+*/
+
+#include "PhysicsObject.h"
+#include "Narrowphase.h"
+#include "Simple_PhysicsEngine.h"
+#include "World.h"
+#include "Scene.h"
+#include "SceneFile.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <string>
+#include <utility>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+volatile double bench_sink;
+
+// tabela wyników, stderr gdy JSON jest wypisywany na stdout
+static FILE *report = stdout;
+
+/**
+ * @brief wynik jednego benchmarku - rozkład czasu jednej operacji w próbkach
+ */
+struct BenchResult {
+    std::string name;
+    size_t iterations; ///< liczba operacji w jednej próbce
+    size_t samples; ///< liczba próbek
+    double min_ns, median_ns, mean_ns, stddev_ns; ///< czas jednej operacji [ns]
+};
+
+/**
+ * @brief ustawienia pomiaru
+ */
+struct BenchOptions {
+    size_t samples = 15; ///< liczba mierzonych próbek
+    double sample_time = 0.02; ///< docelowy czas jednej próbki [s]
+    double warmup_time = 0.1; ///< czas rozgrzewki [s]
+    unsigned threads = 1; ///< liczba wątków silnika w benchmarkach onTick
+    const char *filter = nullptr; ///< uruchamiaj tylko benchmarki zawierające ten tekst
+};
+
+// wywołuje op( i ) dla i = 0..iterations-1 i zwraca czas w sekundach
+template<class F>
+static double time_batch( F &op, size_t iterations )
+{
+    using namespace std::chrono;
+
+    const auto start = steady_clock::now();
+
+    for( size_t i = 0; i < iterations; i++ )
+        op( i );
+
+    return duration<double>( steady_clock::now() - start ).count();
+}
+
+/**
+ * @brief mierzy op( size_t i ) - najpierw rozgrzewa i dobiera liczbę operacji
+ *        w próbce tak, by próbka trwała około sample_time, a następnie
+ *        mierzy samples próbek
+ */
+template<class F>
+static BenchResult run_bench( const BenchOptions &options, const char *name, F &&op )
+{
+    // rozgrzewka, jednocześnie szacuje czas jednej operacji
+    size_t iterations = 1;
+    double elapsed = 0.0, warmup = 0.0;
+
+    while( warmup < options.warmup_time )
+    {
+        elapsed = time_batch( op, iterations );
+        warmup += elapsed;
+
+        if( elapsed < options.sample_time / 2 )
+            iterations *= 2;
+    }
+
+    iterations = std::max<size_t>( 1,
+        (size_t)( iterations * options.sample_time / std::max( elapsed, 1e-9 ) ) );
+
+    std::vector<double> ns_per_op;
+    for( size_t s = 0; s < options.samples; s++ )
+        ns_per_op.push_back( time_batch( op, iterations ) * 1e9 / iterations );
+
+    std::sort( ns_per_op.begin(), ns_per_op.end() );
+
+    double mean = 0.0;
+    for( double t : ns_per_op )
+        mean += t;
+    mean /= ns_per_op.size();
+
+    double variance = 0.0;
+    for( double t : ns_per_op )
+        variance += ( t - mean ) * ( t - mean );
+    variance /= std::max<size_t>( 1, ns_per_op.size() - 1 );
+
+    const size_t half = ns_per_op.size() / 2;
+    const double median = ns_per_op.size() % 2 ? ns_per_op[half] :
+        ( ns_per_op[half - 1] + ns_per_op[half] ) / 2;
+
+    BenchResult result;
+    result.name = name;
+    result.iterations = iterations;
+    result.samples = ns_per_op.size();
+    result.min_ns = ns_per_op.front();
+    result.median_ns = median;
+    result.mean_ns = mean;
+    result.stddev_ns = sqrt( variance );
+
+    fprintf( report, "%-32s %14.1f %14.1f %10.1f%% %12zu\n",
+        name, result.median_ns, result.min_ns,
+        result.stddev_ns * 100.0 / result.mean_ns, iterations );
+    fflush( report );
+
+    return result;
+}
+
+// chmura punktów rozrzuconych w kole o promieniu radius
+static std::vector<glm::dvec2> make_point_cloud( std::mt19937 &rng, int count, double radius )
+{
+    std::uniform_real_distribution<double> unit( -1.0, 1.0 );
+
+    std::vector<glm::dvec2> points;
+    while( (int)points.size() < count )
+    {
+        const glm::dvec2 p( unit( rng ), unit( rng ) );
+        if( glm::dot( p, p ) <= 1.0 )
+            points.push_back( p * radius );
+    }
+
+    return points;
+}
+
+static bool selected( const BenchOptions &options, const char *name )
+{
+    return !options.filter || strstr( name, options.filter );
+}
+
+static void write_json( FILE *out, const BenchOptions &options,
+    const std::vector<BenchResult> &results )
+{
+    fprintf( out, "{\n" );
+    fprintf( out, "  \"simd\": \"%s\",\n", get_simd_level_name( get_simd_level() ) );
+    fprintf( out, "  \"threads\": %u,\n", options.threads );
+    fprintf( out, "  \"benchmarks\": [\n" );
+
+    for( size_t i = 0; i < results.size(); i++ )
+    {
+        const BenchResult &r = results[i];
+        fprintf( out,
+            "    { \"name\": \"%s\", \"iterations\": %zu, \"samples\": %zu, "
+            "\"min_ns\": %.3f, \"median_ns\": %.3f, \"mean_ns\": %.3f, \"stddev_ns\": %.3f }%s\n",
+            r.name.c_str(), r.iterations, r.samples,
+            r.min_ns, r.median_ns, r.mean_ns, r.stddev_ns,
+            i + 1 < results.size() ? "," : "" );
+    }
+
+    fprintf( out, "  ]\n}\n" );
+}
+
+static void print_usage( const char *program )
+{
+    fprintf( stderr,
+        "usage: %s [options]\n"
+        "  --json FILE       write results as JSON to FILE (- for stdout)\n"
+        "  --filter TEXT     run only benchmarks whose name contains TEXT\n"
+        "  --samples N       measured samples per benchmark (default 15)\n"
+        "  --sample-time S   target duration of one sample in seconds (default 0.02)\n"
+        "  --threads N       engine threads for onTick benchmarks (default 1)\n",
+        program );
+}
+
+int main( int argc, char **argv )
+{
+    BenchOptions options;
+    const char *json_path = nullptr;
+
+    for( int i = 1; i < argc; i++ )
+    {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if( !value )
+        {
+            print_usage( argv[0] );
+            return 1;
+        }
+
+        if( !strcmp( arg, "--json" ) ) json_path = value;
+        else if( !strcmp( arg, "--filter" ) ) options.filter = value;
+        else if( !strcmp( arg, "--samples" ) ) options.samples = strtoull( value, nullptr, 10 );
+        else if( !strcmp( arg, "--sample-time" ) ) options.sample_time = strtod( value, nullptr );
+        else if( !strcmp( arg, "--threads" ) ) options.threads = (unsigned)strtoul( value, nullptr, 10 );
+        else
+        {
+            print_usage( argv[0] );
+            return 1;
+        }
+
+        i++;
+    }
+
+    if( options.samples == 0 || options.sample_time <= 0.0 )
+    {
+        print_usage( argv[0] );
+        return 1;
+    }
+
+    if( json_path && !strcmp( json_path, "-" ) )
+        report = stderr;
+
+    fprintf( report, "%-32s %14s %14s %11s %12s\n",
+        "benchmark", "median [ns]", "min [ns]", "stddev", "iterations" );
+
+    std::vector<BenchResult> results;
+    std::mt19937 rng( 2023 );
+
+    // zestaw danych powtarzany w pętli, by nie mierzyć jednego przypadku
+    const size_t set_size = 256;
+
+    // otoczka wypukła, środek i moment bezwładności z chmury punktów
+    for( int point_count : { 8, 64 } )
+    {
+        const std::string name = "PhysicsObject/" + std::to_string( point_count ) + "pts";
+        if( !selected( options, name.c_str() ) ) continue;
+
+        std::vector<std::vector<glm::dvec2>> clouds;
+        for( size_t i = 0; i < set_size; i++ )
+            clouds.push_back( make_point_cloud( rng, point_count, 1.0 ) );
+
+        results.push_back( run_bench( options, name.c_str(), [&]( size_t i )
+        {
+            const PhysicsObject obj( clouds[i % set_size], 1.0 );
+            bench_sink = obj.inv_mass;
+        } ) );
+    }
+
+    std::vector<PhysicsObject> objects;
+    std::vector<glm::dvec2> query_points;
+    std::uniform_real_distribution<double> unit( -1.5, 1.5 );
+    std::uniform_real_distribution<double> rotation( -M_PI, M_PI );
+
+    for( size_t i = 0; i < set_size; i++ )
+    {
+        objects.emplace_back( make_point_cloud( rng, 16, 1.0 ), 1.0 );
+        objects.back().move_by( glm::dvec2( 0.0 ), rotation( rng ) );
+        query_points.push_back( objects.back().center + glm::dvec2( unit( rng ), unit( rng ) ) );
+    }
+
+    if( selected( options, "get_closest_edge" ) )
+        results.push_back( run_bench( options, "get_closest_edge", [&]( size_t i )
+        {
+            const Edge e = objects[i % set_size].get_closest_edge( query_points[i % set_size] );
+            bench_sink = e.a.x;
+        } ) );
+
+    if( selected( options, "is_point_inside_object" ) )
+        results.push_back( run_bench( options, "is_point_inside_object", [&]( size_t i )
+        {
+            bench_sink = objects[i % set_size].is_point_inside_object( query_points[i % set_size] );
+        } ) );
+
+    if( selected( options, "get_shortest_edge_point_dist" ) )
+        results.push_back( run_bench( options, "get_shortest_edge_point_dist", [&]( size_t i )
+        {
+            const PhysicsObject &a = objects[i % set_size];
+            const PhysicsObject &b = objects[( i + 1 ) % set_size];
+            const auto [edge, point] = get_shortest_edge_point_dist(
+                a.get_polygon(), b.get_polygon() );
+            bench_sink = point.x + edge.a.x;
+        } ) );
+
+    // test pary wywoływany przez silnik dla każdej pary z szerokiej fazy
+    if( selected( options, "is_potentially_colliding" ) )
+    {
+        std::vector<AABB> aabbs;
+        std::vector<uint32_t> flags;
+        for( size_t i = 0; i < set_size; i++ )
+        {
+            // przesunięte obiekty, by część par się nie przecinała
+            const glm::dvec2 offset( unit( rng ), unit( rng ) );
+            const AABB aabb = objects[i].get_aabb();
+            aabbs.push_back( AABB{ aabb.min + offset, aabb.max + offset } );
+            flags.push_back( i % 8 ? 0 : PhysicsObject::Immovable );
+        }
+
+        results.push_back( run_bench( options, "is_potentially_colliding", [&]( size_t i )
+        {
+            const size_t a = i % set_size, b = ( i * 7 + 3 ) % set_size;
+
+            bench_sink = Simple_PhysicsEngine::is_potentially_colliding(
+                aabbs[a], aabbs[b], flags[a], flags[b] );
+        } ) );
+    }
+
+    // pełny krok symulacji dla stosu obiektów leżących na podłodze areny
+    for( size_t body_count : { 10, 100, 1000, 10000 } )
+    {
+        const std::string name = "onTick/" + std::to_string( body_count ) + "bodies";
+        if( !selected( options, name.c_str() ) ) continue;
+
+        World world = create_arena_scene();
+        add_random_polygons( world, body_count, 2023, 0.75 );
+
+        // bez usypiania koszt kroku nie zmienia się gdy stos się uspokoi
+        Simple_PhysicsEngine engine;
+        engine.thread_count = options.threads;
+        engine.sleeping_enabled = false;
+
+        // wszystkie rzędy (do 50 m wysokości) zdążą spaść na podłogę
+        const double dt = 1.0 / 120.0;
+        for( int step = 0; step < 480; step++ )
+            engine.onTick( world, dt );
+
+        results.push_back( run_bench( options, name.c_str(), [&]( size_t )
+        {
+            engine.onTick( world, dt );
+        } ) );
+    }
+
+    // wczytanie sceny z pliku, bez obliczania otoczek i mas obiektów
+    if( selected( options, "load_scene/100000bodies" ) )
+    {
+        const char *scene_path = "phys2D_bench_scene.bin";
+
+        World world = create_arena_scene();
+        add_random_polygons( world, 100000, 2023, 0.5 );
+
+        if( !save_scene( scene_path, world ) )
+        {
+            fprintf( stderr, "cannot save %s\n", scene_path );
+            return 1;
+        }
+
+        results.push_back( run_bench( options, "load_scene/100000bodies", [&]( size_t )
+        {
+            bench_sink = load_scene( scene_path, world );
+        } ) );
+
+        remove( scene_path );
+    }
+
+    if( json_path )
+    {
+        FILE *out = strcmp( json_path, "-" ) ? fopen( json_path, "w" ) : stdout;
+        if( !out )
+        {
+            fprintf( stderr, "cannot open %s\n", json_path );
+            return 1;
+        }
+
+        write_json( out, options, results );
+
+        if( out != stdout )
+            fclose( out );
+    }
+}
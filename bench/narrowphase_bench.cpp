@@ -0,0 +1,127 @@
+/*
+Jakub Janeczko
+porównanie szybkości algorytmów wąskiej fazy w zależności od liczby wierzchołków
+18.10.2026
+*/
+
+#include "PhysicsObject.h"
+#include "Narrowphase.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <stdio.h>
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+volatile int bench_sink;
+
+// wielokąt wypukły o zadanej liczbie wierzchołków wpisany w okrąg
+static PhysicsObject make_polygon( std::mt19937 &rng, int vertex_count, double radius )
+{
+    std::uniform_real_distribution<double> jitter( -0.3, 0.3 );
+
+    std::vector<glm::dvec2> points;
+    for( int i = 0; i < vertex_count; i++ )
+    {
+        const double angle = ( i + jitter( rng ) ) * 2.0 * M_PI / vertex_count;
+        points.push_back( radius * glm::dvec2( cos( angle ), sin( angle ) ) );
+    }
+
+    return PhysicsObject( points, 1.0 );
+}
+
+template<class F>
+static double measure_ns( const std::vector<std::pair<PhysicsObject, PhysicsObject>> &pairs,
+    int repetitions, F &&collide )
+{
+    using namespace std::chrono;
+
+    int hits = 0;
+
+    // rozgrzewka
+    for( const auto &[a, b] : pairs )
+        hits += collide( a.get_polygon(), b.get_polygon() );
+
+    const auto start = steady_clock::now();
+
+    for( int r = 0; r < repetitions; r++ )
+        for( const auto &[a, b] : pairs )
+            hits += collide( a.get_polygon(), b.get_polygon() );
+
+    const double total = duration<double, std::nano>( steady_clock::now() - start ).count();
+
+    // nie pozwól kompilatorowi usunąć wywołań
+    bench_sink = hits;
+
+    return total / ( (double)repetitions * pairs.size() );
+}
+
+int main()
+{
+    std::mt19937 rng( 2023 );
+    std::uniform_real_distribution<double> position( -2.5, 2.5 );
+    std::uniform_real_distribution<double> rotation( -M_PI, M_PI );
+
+    const int pair_count = 256;
+
+    printf( "%10s %16s %16s %16s %10s\n",
+        "vertices", "edge-point [ns]", "SAT [ns]", "GJK+EPA [ns]", "colliding" );
+
+    for( int vertex_count : { 3, 4, 8, 16, 32, 64, 128, 256 } )
+    {
+        std::vector<std::pair<PhysicsObject, PhysicsObject>> pairs;
+
+        for( int i = 0; i < pair_count; i++ )
+        {
+            PhysicsObject a = make_polygon( rng, vertex_count, 1.0 );
+            PhysicsObject b = make_polygon( rng, vertex_count, 1.0 );
+
+            a.move_by( glm::dvec2( 0.0 ), rotation( rng ) );
+            b.move_by( glm::dvec2( position( rng ), position( rng ) ), rotation( rng ) );
+
+            pairs.emplace_back( std::move( a ), std::move( b ) );
+        }
+
+        // około 2^20 wierzchołków na pomiar
+        const int repetitions = std::max( 1, ( 1 << 20 ) / ( vertex_count * pair_count ) );
+
+        int colliding = 0;
+        for( const auto &[a, b] : pairs )
+        {
+            Manifold manifold;
+            SATCache cache;
+            colliding += collide_sat( a.get_polygon(), b.get_polygon(), cache, manifold );
+        }
+
+        const double edge_point = measure_ns( pairs, repetitions,
+            []( const Polygon &a, const Polygon &b )
+            {
+                Manifold manifold;
+                return collide_edge_point( a, b, manifold );
+            } );
+
+        const double sat = measure_ns( pairs, repetitions,
+            []( const Polygon &a, const Polygon &b )
+            {
+                Manifold manifold;
+                SATCache cache;
+                return collide_sat( a, b, cache, manifold );
+            } );
+
+        const double gjk_epa = measure_ns( pairs, repetitions,
+            []( const Polygon &a, const Polygon &b )
+            {
+                Manifold manifold;
+                return collide_gjk_epa( a, b, manifold );
+            } );
+
+        printf( "%10d %16.1f %16.1f %16.1f %9d%%\n",
+            vertex_count, edge_point, sat, gjk_epa, colliding * 100 / pair_count );
+    }
+}
@@ -0,0 +1,198 @@
+/*
+Jakub Janeczko
+tablica AABB w układzie SoA i wsadowy test przecięć
+18.10.2026
+*/
+
+#include "AABBArray.h"
+
+#include <vector>
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define PHYS2D_X86
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__)
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE2
+#define TARGET_AVX2
+#endif
+
+constexpr size_t aabb_batch = AABBArray::aabb_batch;
+
+void AABBArray::resize( size_t n )
+{
+    count = n;
+
+    // pusty prostokąt nie przecina żadnego innego
+    const double inf = std::numeric_limits<double>::infinity();
+
+    min_x.assign( n + aabb_batch, inf );
+    min_y.assign( n + aabb_batch, inf );
+    max_x.assign( n + aabb_batch, -inf );
+    max_y.assign( n + aabb_batch, -inf );
+}
+
+void AABBArray::assign( const std::vector<AABB> &aabbs )
+{
+    resize( aabbs.size() );
+
+    for( size_t i = 0; i < count; i++ )
+    {
+        min_x[i] = aabbs[i].min.x;
+        min_y[i] = aabbs[i].min.y;
+        max_x[i] = aabbs[i].max.x;
+        max_y[i] = aabbs[i].max.y;
+    }
+}
+
+void AABBArray::assign( const std::vector<AABB> &aabbs, const std::vector<uint32_t> &order )
+{
+    resize( order.size() );
+
+    for( size_t i = 0; i < count; i++ )
+    {
+        const AABB &aabb = aabbs[order[i]];
+
+        min_x[i] = aabb.min.x;
+        min_y[i] = aabb.min.y;
+        max_x[i] = aabb.max.x;
+        max_y[i] = aabb.max.y;
+    }
+}
+
+static uint32_t overlap_mask_scalar( const AABB &box, const AABBArray &boxes, size_t first )
+{
+    uint32_t mask = 0;
+
+    for( size_t k = 0; k < aabb_batch; k++ )
+    {
+        const size_t i = first + k;
+
+        const bool overlaps =
+            box.min.x <= boxes.max_x[i] && boxes.min_x[i] <= box.max.x &&
+            box.min.y <= boxes.max_y[i] && boxes.min_y[i] <= box.max.y;
+
+        mask |= (uint32_t)overlaps << k;
+    }
+
+    return mask;
+}
+
+#ifdef PHYS2D_X86
+
+TARGET_SSE2
+static uint32_t overlap_mask_sse2( const AABB &box, const AABBArray &boxes, size_t first )
+{
+    const __m128d box_min_x = _mm_set1_pd( box.min.x ), box_min_y = _mm_set1_pd( box.min.y );
+    const __m128d box_max_x = _mm_set1_pd( box.max.x ), box_max_y = _mm_set1_pd( box.max.y );
+
+    uint32_t mask = 0;
+
+    for( size_t k = 0; k < aabb_batch; k += 2 )
+    {
+        const size_t i = first + k;
+
+        const __m128d x = _mm_and_pd(
+            _mm_cmple_pd( box_min_x, _mm_loadu_pd( &boxes.max_x[i] ) ),
+            _mm_cmple_pd( _mm_loadu_pd( &boxes.min_x[i] ), box_max_x ) );
+        const __m128d y = _mm_and_pd(
+            _mm_cmple_pd( box_min_y, _mm_loadu_pd( &boxes.max_y[i] ) ),
+            _mm_cmple_pd( _mm_loadu_pd( &boxes.min_y[i] ), box_max_y ) );
+
+        mask |= (uint32_t)_mm_movemask_pd( _mm_and_pd( x, y ) ) << k;
+    }
+
+    return mask;
+}
+
+TARGET_AVX2
+static uint32_t overlap_mask_avx2( const AABB &box, const AABBArray &boxes, size_t first )
+{
+    const __m256d box_min_x = _mm256_set1_pd( box.min.x ), box_min_y = _mm256_set1_pd( box.min.y );
+    const __m256d box_max_x = _mm256_set1_pd( box.max.x ), box_max_y = _mm256_set1_pd( box.max.y );
+
+    uint32_t mask = 0;
+
+    for( size_t k = 0; k < aabb_batch; k += 4 )
+    {
+        const size_t i = first + k;
+
+        const __m256d x = _mm256_and_pd(
+            _mm256_cmp_pd( box_min_x, _mm256_loadu_pd( &boxes.max_x[i] ), _CMP_LE_OQ ),
+            _mm256_cmp_pd( _mm256_loadu_pd( &boxes.min_x[i] ), box_max_x, _CMP_LE_OQ ) );
+        const __m256d y = _mm256_and_pd(
+            _mm256_cmp_pd( box_min_y, _mm256_loadu_pd( &boxes.max_y[i] ), _CMP_LE_OQ ),
+            _mm256_cmp_pd( _mm256_loadu_pd( &boxes.min_y[i] ), box_max_y, _CMP_LE_OQ ) );
+
+        mask |= (uint32_t)_mm256_movemask_pd( _mm256_and_pd( x, y ) ) << k;
+    }
+
+    return mask;
+}
+
+#endif
+
+template<class MaskFunction>
+static void find_overlaps_impl( const AABB &box, const AABBArray &boxes,
+    size_t begin, size_t end, std::vector<uint32_t> &out, MaskFunction &&overlap_mask )
+{
+    for( size_t first = begin; first < end; first += aabb_batch )
+    {
+        uint32_t mask = overlap_mask( box, boxes, first );
+
+        // obetnij prostokąty za końcem przedziału
+        if( end - first < aabb_batch )
+            mask &= ( 1u << ( end - first ) ) - 1;
+
+        while( mask )
+        {
+            out.push_back( (uint32_t)( first + lowest_bit( mask ) ) );
+            mask &= mask - 1;
+        }
+    }
+}
+
+uint32_t overlap_mask( const AABB &box, const AABBArray &boxes, size_t first,
+    SimdLevel level )
+{
+#ifdef PHYS2D_X86
+    switch( level )
+    {
+    case SimdLevel::AVX2: return overlap_mask_avx2( box, boxes, first );
+    case SimdLevel::SSE2: return overlap_mask_sse2( box, boxes, first );
+    default: break;
+    }
+#else
+    (void)level;
+#endif
+
+    return overlap_mask_scalar( box, boxes, first );
+}
+
+void find_overlaps( const AABB &box, const AABBArray &boxes, size_t begin, size_t end,
+    std::vector<uint32_t> &out, SimdLevel level )
+{
+    // wybór wersji raz na całe zapytanie, nie dla każdego wsadu
+#ifdef PHYS2D_X86
+    switch( level )
+    {
+    case SimdLevel::AVX2:
+        find_overlaps_impl( box, boxes, begin, end, out, overlap_mask_avx2 );
+        return;
+    case SimdLevel::SSE2:
+        find_overlaps_impl( box, boxes, begin, end, out, overlap_mask_sse2 );
+        return;
+    default:
+        break;
+    }
+#else
+    (void)level;
+#endif
+
+    find_overlaps_impl( box, boxes, begin, end, out, overlap_mask_scalar );
+}
@@ -0,0 +1,87 @@
+/*
+Jakub Janeczko
+nagłówek tablicy AABB w układzie SoA i wsadowego testu przecięć
+18.10.2026
+*/
+
+#pragma once
+
+#include "Shape.h"
+#include "CpuFeatures.h"
+
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @brief tablica AABB przechowywana jako cztery osobne tablice współrzędnych
+ * 
+ * pozwala sprawdzać przecięcie jednego AABB z aabb_batch AABB naraz
+ * instrukcjami wektorowymi. Tablice są dopełnione aabb_batch pustymi
+ * prostokątami (min = +inf, max = -inf), które nie przecinają niczego,
+ * więc wsad zaczynający się na dowolnym indeksie < size() można wczytać w całości
+ */
+class AABBArray {
+public:
+    static constexpr size_t aabb_batch = 8; ///< liczba AABB sprawdzanych naraz
+
+    std::vector<double> min_x, min_y; ///< lewe dolne rogi [m]
+    std::vector<double> max_x, max_y; ///< prawe górne rogi [m]
+
+    /**
+     * @brief zastępuje zawartość tablicy prostokątami aabbs
+     */
+    void assign( const std::vector<AABB> &aabbs );
+
+    /**
+     * @brief zastępuje zawartość tablicy prostokątami aabbs w kolejności order
+     * 
+     * i-ty element tablicy to aabbs[order[i]]
+     */
+    void assign( const std::vector<AABB> &aabbs, const std::vector<uint32_t> &order );
+
+    size_t size() const { return count; } ///< liczba prostokątów bez dopełnienia
+
+private:
+    size_t count = 0;
+
+    void resize( size_t n );
+};
+
+/**
+ * @brief sprawdza przecięcie box z prostokątami [first, first + aabb_batch) tablicy
+ * 
+ * @return maska bitowa, bit k jest ustawiony gdy box przecina lub styka się
+ *         z prostokątem first + k. Bity prostokątów poza size() są zerowe
+ */
+uint32_t overlap_mask( const AABB &box, const AABBArray &boxes, size_t first,
+    SimdLevel level = get_simd_level() );
+
+/**
+ * @brief dopisuje do out indeksy prostokątów z przedziału [begin, end)
+ *        które przecinają box lub się z nim stykają
+ * 
+ * indeksy są dopisywane rosnąco, poprzednia zawartość out zostaje zachowana
+ */
+void find_overlaps( const AABB &box, const AABBArray &boxes, size_t begin, size_t end,
+    std::vector<uint32_t> &out, SimdLevel level = get_simd_level() );
+
+/**
+ * @brief zwraca indeks najmłodszego ustawionego bitu maski, mask != 0
+ * 
+ * służy do przechodzenia po bitach wyniku overlap_mask
+ */
+inline uint32_t lowest_bit( uint32_t mask )
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward( &index, mask );
+    return (uint32_t)index;
+#else
+    return (uint32_t)__builtin_ctz( mask );
+#endif
+}
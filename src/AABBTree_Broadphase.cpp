@@ -0,0 +1,441 @@
+/*
+Jakub Janeczko
+szeroka faza oparta na dynamicznym drzewie AABB
+18.10.2026
+*/
+
+#include "AABBTree_Broadphase.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <assert.h>
+
+// liczba obiektów przeszukiwanych w jednym zadaniu
+constexpr size_t query_grain = 256;
+
+static AABB aabb_union( const AABB &a, const AABB &b )
+{
+    return AABB{ glm::min( a.min, b.min ), glm::max( a.max, b.max ) };
+}
+
+// obwód AABB, miara kosztu węzła w drzewie
+static double perimeter( const AABB &a )
+{
+    const glm::dvec2 d = a.max - a.min;
+    return 2.0 * ( d.x + d.y );
+}
+
+static bool contains( const AABB &outer, const AABB &inner )
+{
+    return glm::all(
+            glm::lessThanEqual( outer.min, inner.min ) &&
+            glm::lessThanEqual( inner.max, outer.max )
+        );
+}
+
+int32_t AABBTree_Broadphase::allocate_node()
+{
+    if( free_list == null_node )
+    {
+        nodes.push_back( Node{} );
+        free_list = (int32_t)nodes.size() - 1;
+        nodes[free_list].parent = null_node;
+    }
+
+    const int32_t node = free_list;
+    free_list = nodes[node].parent;
+
+    nodes[node].parent = null_node;
+    nodes[node].child1 = null_node;
+    nodes[node].child2 = null_node;
+    nodes[node].height = 0;
+
+    return node;
+}
+
+void AABBTree_Broadphase::free_node( int32_t node )
+{
+    nodes[node].parent = free_list;
+    nodes[node].height = -1;
+    free_list = node;
+}
+
+int32_t AABBTree_Broadphase::create_leaf( uint32_t body, const AABB &aabb )
+{
+    const int32_t leaf = allocate_node();
+    const glm::dvec2 margin( fat_margin );
+
+    nodes[leaf].aabb = AABB{ aabb.min - margin, aabb.max + margin };
+    nodes[leaf].body = body;
+
+    insert_leaf( leaf );
+    return leaf;
+}
+
+// wstawia liść w miejsce o najmniejszym koszcie (sumie obwodów)
+void AABBTree_Broadphase::insert_leaf( int32_t leaf )
+{
+    if( root == null_node )
+    {
+        root = leaf;
+        nodes[root].parent = null_node;
+        return;
+    }
+
+    const AABB leaf_aabb = nodes[leaf].aabb;
+
+    // znajdź najlepsze rodzeństwo dla nowego liścia
+    int32_t idx = root;
+    while( !nodes[idx].is_leaf() )
+    {
+        const Node &node = nodes[idx];
+
+        const double area = perimeter( node.aabb );
+        const double combined_area = perimeter( aabb_union( node.aabb, leaf_aabb ) );
+
+        // koszt utworzenia nowego rodzica dla tego węzła i liścia
+        const double cost = 2.0 * combined_area;
+
+        // minimalny koszt zejścia w dół drzewa
+        const double inheritance_cost = 2.0 * ( combined_area - area );
+
+        const auto descend_cost = [&]( int32_t child )
+        {
+            const Node &c = nodes[child];
+            const double new_area = perimeter( aabb_union( c.aabb, leaf_aabb ) );
+
+            return c.is_leaf() ?
+                new_area + inheritance_cost :
+                new_area - perimeter( c.aabb ) + inheritance_cost;
+        };
+
+        const double cost1 = descend_cost( node.child1 );
+        const double cost2 = descend_cost( node.child2 );
+
+        if( cost < cost1 && cost < cost2 ) break;
+
+        idx = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    const int32_t sibling = idx;
+
+    // utwórz nowego rodzica
+    const int32_t old_parent = nodes[sibling].parent;
+    const int32_t new_parent = allocate_node();
+
+    nodes[new_parent].parent = old_parent;
+    nodes[new_parent].aabb = aabb_union( leaf_aabb, nodes[sibling].aabb );
+    nodes[new_parent].height = nodes[sibling].height + 1;
+    nodes[new_parent].child1 = sibling;
+    nodes[new_parent].child2 = leaf;
+
+    nodes[sibling].parent = new_parent;
+    nodes[leaf].parent = new_parent;
+
+    if( old_parent != null_node )
+    {
+        if( nodes[old_parent].child1 == sibling )
+            nodes[old_parent].child1 = new_parent;
+        else
+            nodes[old_parent].child2 = new_parent;
+    }
+    else
+        root = new_parent;
+
+    // popraw wysokości i AABB przodków
+    idx = nodes[leaf].parent;
+    while( idx != null_node )
+    {
+        idx = balance( idx );
+
+        Node &node = nodes[idx];
+        node.height = 1 + std::max( nodes[node.child1].height, nodes[node.child2].height );
+        node.aabb = aabb_union( nodes[node.child1].aabb, nodes[node.child2].aabb );
+
+        idx = node.parent;
+    }
+}
+
+void AABBTree_Broadphase::remove_leaf( int32_t leaf )
+{
+    if( leaf == root )
+    {
+        root = null_node;
+        return;
+    }
+
+    const int32_t parent = nodes[leaf].parent;
+    const int32_t grand_parent = nodes[parent].parent;
+    const int32_t sibling = nodes[parent].child1 == leaf ?
+        nodes[parent].child2 : nodes[parent].child1;
+
+    // zastąp rodzica rodzeństwem liścia
+    if( grand_parent != null_node )
+    {
+        if( nodes[grand_parent].child1 == parent )
+            nodes[grand_parent].child1 = sibling;
+        else
+            nodes[grand_parent].child2 = sibling;
+
+        nodes[sibling].parent = grand_parent;
+        free_node( parent );
+
+        int32_t idx = grand_parent;
+        while( idx != null_node )
+        {
+            idx = balance( idx );
+
+            Node &node = nodes[idx];
+            node.height = 1 + std::max( nodes[node.child1].height, nodes[node.child2].height );
+            node.aabb = aabb_union( nodes[node.child1].aabb, nodes[node.child2].aabb );
+
+            idx = node.parent;
+        }
+    }
+    else
+    {
+        root = sibling;
+        nodes[sibling].parent = null_node;
+        free_node( parent );
+    }
+}
+
+// jeżeli poddrzewo o korzeniu w a jest niezrównoważone to obróć je
+// zwraca nowy korzeń poddrzewa
+int32_t AABBTree_Broadphase::balance( int32_t i_a )
+{
+    Node &a = nodes[i_a];
+    if( a.is_leaf() || a.height < 2 )
+        return i_a;
+
+    const int32_t i_b = a.child1;
+    const int32_t i_c = a.child2;
+    Node &b = nodes[i_b];
+    Node &c = nodes[i_c];
+
+    const int32_t diff = c.height - b.height;
+
+    // podnieś c, ponieważ jest za wysokie
+    if( diff > 1 )
+    {
+        const int32_t i_f = c.child1;
+        const int32_t i_g = c.child2;
+        Node &f = nodes[i_f];
+        Node &g = nodes[i_g];
+
+        c.child1 = i_a;
+        c.parent = a.parent;
+        a.parent = i_c;
+
+        if( c.parent != null_node )
+        {
+            if( nodes[c.parent].child1 == i_a )
+                nodes[c.parent].child1 = i_c;
+            else
+                nodes[c.parent].child2 = i_c;
+        }
+        else
+            root = i_c;
+
+        // wyższe z dzieci c zostaje przy c
+        const bool f_higher = f.height > g.height;
+        const int32_t i_stay = f_higher ? i_f : i_g;
+        const int32_t i_move = f_higher ? i_g : i_f;
+        Node &stay = nodes[i_stay];
+        Node &move = nodes[i_move];
+
+        c.child2 = i_stay;
+        a.child2 = i_move;
+        move.parent = i_a;
+
+        a.aabb = aabb_union( b.aabb, move.aabb );
+        c.aabb = aabb_union( a.aabb, stay.aabb );
+
+        a.height = 1 + std::max( b.height, move.height );
+        c.height = 1 + std::max( a.height, stay.height );
+
+        return i_c;
+    }
+
+    // podnieś b, ponieważ jest za wysokie
+    if( diff < -1 )
+    {
+        const int32_t i_d = b.child1;
+        const int32_t i_e = b.child2;
+        Node &d = nodes[i_d];
+        Node &e = nodes[i_e];
+
+        b.child1 = i_a;
+        b.parent = a.parent;
+        a.parent = i_b;
+
+        if( b.parent != null_node )
+        {
+            if( nodes[b.parent].child1 == i_a )
+                nodes[b.parent].child1 = i_b;
+            else
+                nodes[b.parent].child2 = i_b;
+        }
+        else
+            root = i_b;
+
+        // wyższe z dzieci b zostaje przy b
+        const bool d_higher = d.height > e.height;
+        const int32_t i_stay = d_higher ? i_d : i_e;
+        const int32_t i_move = d_higher ? i_e : i_d;
+        Node &stay = nodes[i_stay];
+        Node &move = nodes[i_move];
+
+        b.child2 = i_stay;
+        a.child1 = i_move;
+        move.parent = i_a;
+
+        a.aabb = aabb_union( c.aabb, move.aabb );
+        b.aabb = aabb_union( a.aabb, stay.aabb );
+
+        a.height = 1 + std::max( c.height, move.height );
+        b.height = 1 + std::max( a.height, stay.height );
+
+        return i_b;
+    }
+
+    return i_a;
+}
+
+template<class F>
+void AABBTree_Broadphase::query( const AABB &aabb, std::vector<int32_t> &stack,
+    uint64_t &tests, F &&callback ) const
+{
+    stack.clear();
+    if( root != null_node )
+        stack.push_back( root );
+
+    while( !stack.empty() )
+    {
+        const int32_t idx = stack.back();
+        stack.pop_back();
+
+        const Node &node = nodes[idx];
+        tests++;
+        if( !node.aabb.overlaps( aabb ) )
+            continue;
+
+        if( node.is_leaf() )
+            callback( node.body );
+        else
+        {
+            stack.push_back( node.child1 );
+            stack.push_back( node.child2 );
+        }
+    }
+}
+
+void AABBTree_Broadphase::find_pairs( const std::vector<AABB> &aabbs,
+    std::vector<BodyPair> &pairs )
+{
+    pairs.clear();
+    thread_tests.reset( get_thread_count() );
+
+    const uint32_t n = (uint32_t)aabbs.size();
+    const uint32_t old_n = (uint32_t)leaf_of_body.size();
+
+    // ubyło obiektów - usuń liście ostatnich indeksów i ich pary
+    // (World::remove przesuwa dalsze obiekty, więc ich liście są
+    // przenoszone poniżej jak liście obiektów które się poruszyły)
+    if( n < old_n )
+    {
+        for( uint32_t i = n; i < old_n; i++ )
+        {
+            remove_leaf( leaf_of_body[i] );
+            free_node( leaf_of_body[i] );
+        }
+
+        leaf_of_body.resize( n );
+
+        fat_pairs.erase( std::remove_if( fat_pairs.begin(), fat_pairs.end(),
+            [n]( const BodyPair &p ) { return p.second >= n; } ), fat_pairs.end() );
+    }
+
+    moved.assign( n, 0 );
+    bool any_moved = false;
+
+    // przenieś tylko te liście z których obiekty wyszły
+    for( uint32_t i = 0; i < std::min( n, old_n ); i++ )
+    {
+        const int32_t leaf = leaf_of_body[i];
+        if( contains( nodes[leaf].aabb, aabbs[i] ) )
+            continue;
+
+        remove_leaf( leaf );
+        free_node( leaf );
+        leaf_of_body[i] = create_leaf( i, aabbs[i] );
+
+        moved[i] = 1;
+        any_moved = true;
+    }
+
+    // przybyło obiektów - wstaw tylko nowe liście
+    for( uint32_t i = old_n; i < n; i++ )
+    {
+        leaf_of_body.push_back( create_leaf( i, aabbs[i] ) );
+
+        moved[i] = 1;
+        any_moved = true;
+    }
+
+    if( any_moved )
+    {
+        // pary z przeniesionymi obiektami mogły przestać istnieć
+        fat_pairs.erase( std::remove_if( fat_pairs.begin(), fat_pairs.end(),
+            [this]( const BodyPair &p ) { return moved[p.first] || moved[p.second]; } ),
+            fat_pairs.end() );
+
+        const size_t old_count = fat_pairs.size();
+
+        // drzewo nie zmienia się w trakcie zapytań - przeszukuj równolegle,
+        // każdy wątek ze swoim stosem
+        stacks.resize( get_thread_count() );
+        chunk_pairs.reset( JobSystem::chunk_count( n, query_grain ) );
+
+        parallel_for( jobs, n, query_grain, [&]( const JobRange &range )
+        {
+            std::vector<BodyPair> &out = chunk_pairs[range.chunk];
+
+            for( uint32_t i = (uint32_t)range.begin; i < range.end; i++ )
+            {
+                if( !moved[i] ) continue;
+
+                query( nodes[leaf_of_body[i]].aabb, stacks[range.thread],
+                    thread_tests[range.thread], [&]( uint32_t j )
+                {
+                    // para dwóch przeniesionych obiektów zostanie znaleziona raz
+                    if( j == i || ( moved[j] && j < i ) )
+                        return;
+
+                    out.emplace_back( std::min( i, j ), std::max( i, j ) );
+                } );
+            }
+        } );
+
+        chunk_pairs.append_to( fat_pairs );
+
+        // połącz nowe pary ze starymi (bez std::inplace_merge, który alokuje pamięć)
+        std::sort( fat_pairs.begin() + old_count, fat_pairs.end() );
+
+        merge_buffer.resize( fat_pairs.size() );
+        std::merge( fat_pairs.begin(), fat_pairs.begin() + old_count,
+                    fat_pairs.begin() + old_count, fat_pairs.end(),
+                    merge_buffer.begin() );
+
+        fat_pairs.swap( merge_buffer );
+    }
+
+    // zwróć tylko pary których dokładne AABB się przecinają
+    for( const BodyPair &p : fat_pairs )
+        if( aabbs[p.first].overlaps( aabbs[p.second] ) )
+            pairs.push_back( p );
+
+    aabb_tests = thread_tests.merged() + fat_pairs.size();
+}
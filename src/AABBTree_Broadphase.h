@@ -0,0 +1,80 @@
+/*
+Jakub Janeczko
+nagłówek szerokiej fazy opartej na dynamicznym drzewie AABB
+18.10.2026
+*/
+
+#pragma once
+
+#include "Broadphase.h"
+
+#include <vector>
+#include <stdint.h>
+
+/**
+ * @brief szeroka faza oparta na dynamicznym drzewie AABB
+ * 
+ * każdy obiekt jest liściem drzewa z powiększonym ("tłustym") AABB,
+ * liść zostaje przeniesiony w drzewie tylko wtedy, gdy obiekt wyjdzie
+ * poza swój powiększony AABB
+ * 
+ * drzewo jest utrzymywane w równowadze rotacjami (tak jak drzewo AVL),
+ * a nowe liście są wstawiane w miejsce minimalizujące sumę obwodów węzłów
+ * 
+ * pary powiększonych AABB są pamiętane pomiędzy krokami, więc przeszukiwane
+ * są tylko obiekty które zostały przeniesione - gdy większość obiektów
+ * spoczywa koszt jest prawie zerowy
+ * 
+ * drzewo nie jest budowane od nowa gdy zmieni się liczba obiektów: nowe
+ * obiekty (na końcu tablicy) są wstawiane jako nowe liście, a po usunięciu
+ * obiektów usuwane są liście ostatnich indeksów - obiekty przesunięte na
+ * inne indeksy mają liście po swoich poprzednikach i są przenoszone tak jak
+ * obiekty które wyszły poza powiększony AABB
+ */
+class AABBTree_Broadphase : public IBroadphase {
+public:
+    virtual void find_pairs( const std::vector<AABB> &aabbs,
+        std::vector<BodyPair> &pairs );
+
+    double fat_margin = 0.5; ///< o ile AABB w drzewie jest powiększony z każdej strony [m]
+
+private:
+    static constexpr int32_t null_node = -1;
+
+    struct Node {
+        AABB aabb; ///< powiększony AABB liścia lub AABB obejmujący dzieci
+        int32_t parent; ///< rodzic lub następny wolny węzeł
+        int32_t child1, child2; ///< dzieci, null_node dla liści
+        int32_t height; ///< 0 dla liści, -1 dla wolnych węzłów
+        uint32_t body; ///< indeks obiektu liścia
+
+        bool is_leaf() const { return child1 == null_node; }
+    };
+
+    std::vector<Node> nodes;
+    int32_t root = null_node;
+    int32_t free_list = null_node;
+
+    std::vector<int32_t> leaf_of_body; ///< liść odpowiadający obiektowi
+    std::vector<BodyPair> fat_pairs; ///< posortowane pary z przecinającymi się powiększonymi AABB
+    std::vector<BodyPair> merge_buffer; ///< bufor do łączenia starych i nowych par
+
+    std::vector<uint8_t> moved; ///< czy obiekt został przeniesiony w tym kroku
+    std::vector<std::vector<int32_t>> stacks; ///< stosy do przeszukiwania drzewa, jeden na wątek
+    ChunkOutput<BodyPair> chunk_pairs; ///< nowe pary znalezione w kolejnych fragmentach
+
+    int32_t allocate_node();
+    void free_node( int32_t node );
+
+    int32_t create_leaf( uint32_t body, const AABB &aabb );
+
+    void insert_leaf( int32_t leaf );
+    void remove_leaf( int32_t leaf );
+    int32_t balance( int32_t node );
+
+    // wywołuje callback( body ) dla liści przecinających aabb,
+    // do tests dodaje liczbę sprawdzonych węzłów
+    template<class F>
+    void query( const AABB &aabb, std::vector<int32_t> &stack, uint64_t &tests,
+        F &&callback ) const;
+};
@@ -0,0 +1,139 @@
+/*
+Jakub Janeczko
+licznik alokacji pamięci
+18.10.2026
+*/
+
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+
+static std::atomic<uint64_t> allocation_count{ 0 };
+static thread_local bool thread_counted = true; ///< czy zliczać alokacje obecnego wątku
+
+uint64_t get_allocation_count()
+{
+    return allocation_count.load( std::memory_order_relaxed );
+}
+
+void count_thread_allocations( bool enabled )
+{
+    thread_counted = enabled;
+}
+
+// zastąp globalne operatory new by zliczać alokacje - wszystkie warianty,
+// bo biblioteka standardowa nie musi kierować ich do jednego (np. libstdc++
+// przydziela pamięć wyrównaną ponad domyślne wyrównanie przez aligned_alloc)
+
+// przydziela pamięć przez malloc (alignment == 0) lub wyrównaną do alignment
+// (zwalnianą przez deallocate_aligned), wywołując new_handler gdy jej brak
+static void *allocate( size_t size, size_t alignment )
+{
+    if( thread_counted )
+        allocation_count.fetch_add( 1, std::memory_order_relaxed );
+
+    if( size == 0 ) size = 1;
+
+    while( true )
+    {
+        void *ptr;
+
+        if( alignment == 0 )
+            ptr = malloc( size );
+        else
+        {
+#if defined(_WIN32)
+            ptr = _aligned_malloc( size, alignment );
+#else
+            // rozmiar musi być wielokrotnością wyrównania
+            ptr = aligned_alloc( alignment, ( size + alignment - 1 ) / alignment * alignment );
+#endif
+        }
+
+        if( ptr )
+            return ptr;
+
+        std::new_handler handler = std::get_new_handler();
+        if( !handler ) throw std::bad_alloc();
+
+        handler();
+    }
+}
+
+static void *allocate_nothrow( size_t size, size_t alignment ) noexcept
+{
+    try
+    {
+        return allocate( size, alignment );
+    }
+    catch( ... )
+    {
+        return nullptr;
+    }
+}
+
+static void deallocate_aligned( void *ptr ) noexcept
+{
+#if defined(_WIN32)
+    _aligned_free( ptr );
+#else
+    free( ptr );
+#endif
+}
+
+void *operator new( size_t size ) { return allocate( size, 0 ); }
+void *operator new[]( size_t size ) { return allocate( size, 0 ); }
+
+void *operator new( size_t size, const std::nothrow_t& ) noexcept
+{
+    return allocate_nothrow( size, 0 );
+}
+
+void *operator new[]( size_t size, const std::nothrow_t& ) noexcept
+{
+    return allocate_nothrow( size, 0 );
+}
+
+void *operator new( size_t size, std::align_val_t alignment )
+{
+    return allocate( size, (size_t)alignment );
+}
+
+void *operator new[]( size_t size, std::align_val_t alignment )
+{
+    return allocate( size, (size_t)alignment );
+}
+
+void *operator new( size_t size, std::align_val_t alignment, const std::nothrow_t& ) noexcept
+{
+    return allocate_nothrow( size, (size_t)alignment );
+}
+
+void *operator new[]( size_t size, std::align_val_t alignment, const std::nothrow_t& ) noexcept
+{
+    return allocate_nothrow( size, (size_t)alignment );
+}
+
+void operator delete( void *ptr ) noexcept { free( ptr ); }
+void operator delete[]( void *ptr ) noexcept { free( ptr ); }
+void operator delete( void *ptr, size_t ) noexcept { free( ptr ); }
+void operator delete[]( void *ptr, size_t ) noexcept { free( ptr ); }
+void operator delete( void *ptr, const std::nothrow_t& ) noexcept { free( ptr ); }
+void operator delete[]( void *ptr, const std::nothrow_t& ) noexcept { free( ptr ); }
+
+void operator delete( void *ptr, std::align_val_t ) noexcept { deallocate_aligned( ptr ); }
+void operator delete[]( void *ptr, std::align_val_t ) noexcept { deallocate_aligned( ptr ); }
+void operator delete( void *ptr, size_t, std::align_val_t ) noexcept { deallocate_aligned( ptr ); }
+void operator delete[]( void *ptr, size_t, std::align_val_t ) noexcept { deallocate_aligned( ptr ); }
+
+void operator delete( void *ptr, std::align_val_t, const std::nothrow_t& ) noexcept
+{
+    deallocate_aligned( ptr );
+}
+
+void operator delete[]( void *ptr, std::align_val_t, const std::nothrow_t& ) noexcept
+{
+    deallocate_aligned( ptr );
+}
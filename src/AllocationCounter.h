@@ -0,0 +1,26 @@
+/*
+Jakub Janeczko
+nagłówek licznika alokacji pamięci
+18.10.2026
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief zwraca liczbę alokacji pamięci (wywołań wszystkich wariantów operator new)
+ *        wykonanych przez program od jego uruchomienia
+ * 
+ * służy do sprawdzania czy gorące pętle nie alokują pamięci -
+ * liczy się różnicę wartości przed i po danym fragmencie kodu
+ */
+uint64_t get_allocation_count();
+
+/**
+ * @brief włącza lub wyłącza zliczanie alokacji wykonywanych przez obecny wątek
+ * 
+ * domyślnie zliczane są alokacje wszystkich wątków - wyłącza się je w wątkach
+ * które działają równolegle z mierzonym fragmentem (np. w wątku rysującym)
+ */
+void count_thread_allocations( bool enabled );
@@ -0,0 +1,66 @@
+/*
+Jakub Janeczko
+interfejs szerokiej fazy wykrywania kolizji
+18.10.2026
+*/
+
+#pragma once
+
+#include "PhysicsObject.h"
+#include "JobSystem.h"
+
+#include <vector>
+#include <utility>
+#include <stdint.h>
+
+/**
+ * @brief para indeksów obiektów, mniejszy indeks jest zawsze pierwszy
+ */
+using BodyPair = std::pair<uint32_t, uint32_t>;
+
+/**
+ * @brief interfejs szerokiej fazy (broadphase) wykrywania kolizji
+ * 
+ * na podstawie AABB obiektów wyznacza pary które mogą ze sobą kolidować,
+ * dokładne sprawdzenie kolizji zostaje pozostawione silnikowi fizyki
+ * 
+ * implementacje mogą przechowywać stan pomiędzy kolejnymi wywołaniami
+ * (wykorzystując to, że obiekty między krokami poruszają się niewiele),
+ * ale muszą poprawnie obsługiwać zmianę liczby obiektów
+ */
+class IBroadphase {
+public:
+    virtual ~IBroadphase() = default;
+
+    /**
+     * @brief znajduje wszystkie pary obiektów o przecinających się AABB
+     * 
+     * każda para zostaje zwrócona dokładnie raz
+     * 
+     * @param aabbs AABB kolejnych obiektów symulacji
+     * @param pairs wyjście, poprzednia zawartość zostaje usunięta
+     */
+    virtual void find_pairs( const std::vector<AABB> &aabbs,
+        std::vector<BodyPair> &pairs ) = 0;
+
+    /**
+     * @brief ustawia system zadań używany do równoległego szukania par
+     * 
+     * nullptr oznacza szukanie w jednym wątku. Znalezione pary i ich kolejność
+     * nie zależą od liczby wątków
+     */
+    void set_job_system( JobSystem *job_system ) { jobs = job_system; }
+
+    /**
+     * @brief zwraca liczbę testów przecięcia AABB wykonanych w ostatnim find_pairs
+     */
+    uint64_t get_aabb_tests() const { return aabb_tests; }
+
+protected:
+    JobSystem *jobs = nullptr; ///< system zadań lub nullptr
+
+    uint64_t aabb_tests = 0; ///< testy AABB w ostatnim find_pairs
+    PerThread<uint64_t> thread_tests; ///< testy AABB zliczane przez wątki pętli równoległych
+
+    unsigned get_thread_count() const { return jobs ? jobs->get_thread_count() : 1; }
+};
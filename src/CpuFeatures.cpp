@@ -0,0 +1,69 @@
+/*
+Jakub Janeczko
+wykrywanie rozszerzeń procesora
+18.10.2026
+*/
+
+#include "CpuFeatures.h"
+
+#if defined(_MSC_VER) && ( defined(_M_X64) || defined(_M_IX86) )
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+static SimdLevel detect_simd_level()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    // __builtin_cpu_supports sprawdza też czy system zapisuje rejestry AVX
+    __builtin_cpu_init();
+
+    if( __builtin_cpu_supports( "avx2" ) )
+        return SimdLevel::AVX2;
+
+    if( __builtin_cpu_supports( "sse2" ) )
+        return SimdLevel::SSE2;
+
+    return SimdLevel::Scalar;
+#elif defined(_MSC_VER) && ( defined(_M_X64) || defined(_M_IX86) )
+    int info[4];
+    __cpuid( info, 0 );
+    const int max_leaf = info[0];
+
+    __cpuid( info, 1 );
+    const bool sse2 = info[3] & ( 1 << 26 );
+    const bool osxsave = info[2] & ( 1 << 27 );
+    const bool avx = info[2] & ( 1 << 28 );
+
+    bool avx2 = false;
+    if( max_leaf >= 7 && osxsave && avx )
+    {
+        // system musi zapisywać rejestry XMM i YMM przy przełączaniu wątków
+        const bool os_avx = ( _xgetbv( 0 ) & 6 ) == 6;
+
+        __cpuidex( info, 7, 0 );
+        avx2 = os_avx && ( info[1] & ( 1 << 5 ) );
+    }
+
+    if( avx2 ) return SimdLevel::AVX2;
+    if( sse2 ) return SimdLevel::SSE2;
+    return SimdLevel::Scalar;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+SimdLevel get_simd_level()
+{
+    static const SimdLevel level = detect_simd_level();
+    return level;
+}
+
+const char *get_simd_level_name( SimdLevel level )
+{
+    switch( level )
+    {
+    case SimdLevel::AVX2: return "AVX2";
+    case SimdLevel::SSE2: return "SSE2";
+    default: return u8"skalarne";
+    }
+}
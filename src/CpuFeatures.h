@@ -0,0 +1,29 @@
+/*
+Jakub Janeczko
+nagłówek wykrywania rozszerzeń procesora
+18.10.2026
+*/
+
+#pragma once
+
+/**
+ * @brief zestawy instrukcji wektorowych używane przez jądra obliczeniowe
+ */
+enum class SimdLevel {
+    Scalar, ///< bez instrukcji wektorowych
+    SSE2, ///< 128-bitowe rejestry, 2 liczby double
+    AVX2 ///< 256-bitowe rejestry, 4 liczby double
+};
+
+/**
+ * @brief zwraca najlepszy zestaw instrukcji obsługiwany przez procesor
+ *        i system operacyjny
+ * 
+ * wynik jest wyznaczany raz, przy pierwszym wywołaniu
+ */
+SimdLevel get_simd_level();
+
+/**
+ * @brief zwraca nazwę zestawu instrukcji (do wyświetlenia w interfejsie)
+ */
+const char *get_simd_level_name( SimdLevel level );
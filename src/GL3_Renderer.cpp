@@ -5,6 +5,7 @@ Renderer, czyli wyświetlanie sceny i gui
 */
 
 #include "GL3_Renderer.h"
+#include "Profiler.h"
 
 #define GLFW_INCLUDE_NONE
 #include <glad/gl.h>
@@ -20,6 +21,7 @@ Renderer, czyli wyświetlanie sceny i gui
 
 #include <stdexcept>
 #include <string>
+#include <chrono>
 
 static const char *vert_code = R"(
 #version 330
@@ -164,17 +166,19 @@ GL3_Renderer::~GL3_Renderer()
 }
 
 std::vector<GL3_Renderer::VertexInput>
-GL3_Renderer::prepareVerts( const renderer_info &ri, const std::vector<PhysicsObject> &objs )
+GL3_Renderer::prepareVerts( const renderer_info &ri, const WorldSnapshot &world,
+    double alpha )
 {
     std::vector<VertexInput> verts;
 
-    for( size_t obj_i = 0; obj_i < objs.size(); obj_i++ )
+    for( uint32_t obj_i = 0; obj_i < world.size(); obj_i++ )
     {
-        const PhysicsObject &obj = objs[obj_i];
+        const glm::dvec2 center = world.get_interpolated_center( obj_i, alpha );
+        const double angle = world.get_interpolated_angle( obj_i, alpha );
         
-        for( glm::dvec2 pt : obj.points )
+        for( glm::dvec2 pt : world.get_shapes()[obj_i].get_points( angle ) )
             verts.push_back( {
-                glm::vec2( pt + obj.center ),
+                glm::vec2( pt + center ),
                 ri.object_colors[obj_i]
             } );
     }
@@ -182,15 +186,15 @@ GL3_Renderer::prepareVerts( const renderer_info &ri, const std::vector<PhysicsOb
     return verts;
 }
 
-std::vector<uint32_t> GL3_Renderer::renderTriangles( const std::vector<PhysicsObject> &objs )
+std::vector<uint32_t> GL3_Renderer::renderTriangles( const WorldSnapshot &world )
 {
     std::vector<uint32_t> indices;
 
     uint32_t offset = 0;
 
-    for( const PhysicsObject &obj : objs )
+    for( const Shape &shape : world.get_shapes() )
     {
-        uint32_t point_cnt = (uint32_t)obj.points.size();
+        uint32_t point_cnt = (uint32_t)shape.local_points.size();
         
         // utwórz 'triangle strip' z listy punktów
         uint32_t front_it = offset + 1, 
@@ -214,30 +218,32 @@ std::vector<uint32_t> GL3_Renderer::renderTriangles( const std::vector<PhysicsOb
     return indices;
 }
 
-std::vector<uint32_t> GL3_Renderer::renderLines( const std::vector<PhysicsObject> &objs )
+std::vector<uint32_t> GL3_Renderer::renderLines( const WorldSnapshot &world )
 {
     std::vector<uint32_t> indices;
 
     uint32_t offset = 0;
 
-    for( const PhysicsObject &obj : objs )
+    for( const Shape &shape : world.get_shapes() )
     {
         // utwórz 'line strip' z listy punktów
-        for( uint32_t i = 0; i < obj.points.size(); i++ )
+        for( uint32_t i = 0; i < shape.local_points.size(); i++ )
             indices.push_back( i + offset );
 
         indices.push_back( offset );
         indices.push_back( UINT32_MAX ); // primitive restart index
 
-        offset += (uint32_t)obj.points.size();
+        offset += (uint32_t)shape.local_points.size();
     }
 
     return indices;
 }
 
 bool GL3_Renderer::draw( const renderer_info &ri,
-    const std::vector<PhysicsObject> &objs, double )
+    const WorldSnapshot &world, double )
 {
+    PROFILE_ZONE( "GL3_Renderer::draw" );
+
     ImGui::Render();
 
     int width, height;
@@ -265,8 +271,11 @@ bool GL3_Renderer::draw( const renderer_info &ri,
 
     glUniformMatrix4fv( mViewLocation, 1, GL_FALSE, glm::value_ptr( global_view ) );
     
-    auto verts = prepareVerts( ri, objs );
-    auto indices = ri.fill_objects ? renderTriangles( objs ) : renderLines( objs );
+    const double alpha = ri.interpolate_objects ?
+        world.get_interpolation_factor( std::chrono::steady_clock::now() ) : 1.0;
+
+    auto verts = prepareVerts( ri, world, alpha );
+    auto indices = ri.fill_objects ? renderTriangles( world ) : renderLines( world );
 
     size_t object_vert_count = verts.size();
 
@@ -307,7 +316,11 @@ bool GL3_Renderer::draw( const renderer_info &ri,
     glDrawArrays(GL_TRIANGLES, (GLint)vert_offset, (GLsizei)ri.additional_triangles.size());
 
     ImGui_ImplOpenGL3_RenderDrawData( ImGui::GetDrawData() );
-    glfwSwapBuffers( window );
+
+    {
+        PROFILE_ZONE( "glfwSwapBuffers" );
+        glfwSwapBuffers( window );
+    }
 
     glfwPollEvents();
 
@@ -21,7 +21,7 @@ public:
     ~GL3_Renderer();
 
     virtual bool draw( const renderer_info &ri,
-        const std::vector<PhysicsObject> &objs, double dt );
+        const WorldSnapshot &world, double dt );
 
 private:
     GLFWwindow *window;
@@ -35,8 +35,8 @@ private:
     };
 
     std::vector<VertexInput> prepareVerts( const renderer_info &,
-        const std::vector<PhysicsObject> & );
+        const WorldSnapshot &, double alpha );
         
-    std::vector<uint32_t> renderTriangles( const std::vector<PhysicsObject> & );
-    std::vector<uint32_t> renderLines( const std::vector<PhysicsObject> & );
+    std::vector<uint32_t> renderTriangles( const WorldSnapshot & );
+    std::vector<uint32_t> renderLines( const WorldSnapshot & );
 };
\ No newline at end of file
@@ -6,8 +6,9 @@ klasa łącząca GUI i Renderer
 
 #include "GuiRenderer.h"
 
-bool GuiRenderer::onDraw( std::vector<PhysicsObject> &objs, double dt )
+bool GuiRenderer::onDraw( const WorldSnapshot &world,
+    WorldCommandQueue &commands, double dt )
 {
-    const renderer_info ri = gui->handle_gui( objs, dt );
-    return renderer->draw( ri, objs, dt );
+    const renderer_info ri = gui->handle_gui( world, commands, dt );
+    return renderer->draw( ri, world, dt );
 }
\ No newline at end of file
@@ -7,7 +7,8 @@ nagłówek klasy łączącej GUI i Renderer
 #pragma once
 
 #include "interfaces.h"
-#include "PhysicsObject.h"
+#include "WorldSnapshot.h"
+#include "WorldCommandQueue.h"
 
 #include <glm/glm.hpp>
 
@@ -26,12 +27,13 @@ public:
     /**
      * @brief obsługuje interakcje z użytkownikiem i rysuje GUI wraz z obiektami
      * 
-     * @param objs obiekty w symulacji
-     * @param dt różnica czasu od poprzedniego kroku symulacji
+     * @param world ostatni stan symulacji
+     * @param commands kolejka zmian świata
+     * @param dt różnica czasu od poprzedniej klatki
      * @return true program powinien kontynuować działanie
      * @return false program powinien się zakończyć
      */
-    bool onDraw( std::vector<PhysicsObject> &objs, double dt );
+    bool onDraw( const WorldSnapshot &world, WorldCommandQueue &commands, double dt );
 
 private:
     IGui *gui;
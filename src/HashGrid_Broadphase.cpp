@@ -0,0 +1,162 @@
+/*
+Jakub Janeczko
+szeroka faza oparta na haszowanej siatce
+18.10.2026
+*/
+
+#include "HashGrid_Broadphase.h"
+#include "AABBArray.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <math.h>
+
+// liczba kubełków sprawdzanych w jednym zadaniu
+constexpr size_t bucket_grain = 1024;
+
+static uint32_t cell_hash( int32_t cx, int32_t cy )
+{
+    return (uint32_t)cx * 73856093u ^ (uint32_t)cy * 19349663u;
+}
+
+int32_t HashGrid_Broadphase::cell_coord( double v ) const
+{
+    const double limit = (double)( 1 << 30 );
+    return (int32_t)std::clamp( floor( v / cell_size ), -limit, limit );
+}
+
+void HashGrid_Broadphase::find_pairs( const std::vector<AABB> &aabbs,
+    std::vector<BodyPair> &pairs )
+{
+    pairs.clear();
+
+    const uint32_t n = (uint32_t)aabbs.size();
+    if( n == 0 ) return;
+
+    // dobierz rozmiar komórki na podstawie mediany rozmiarów obiektów
+    extents.resize( n );
+    for( uint32_t i = 0; i < n; i++ )
+    {
+        const glm::dvec2 size = aabbs[i].max - aabbs[i].min;
+        extents[i] = std::max( size.x, size.y );
+    }
+
+    std::nth_element( extents.begin(), extents.begin() + n / 2, extents.end() );
+    const double median = extents[n / 2];
+
+    cell_size = median > 0 ? median * cell_size_factor : 1.0;
+
+    // przypisz obiekty do komórek
+    entries.clear();
+    large.clear();
+
+    for( uint32_t i = 0; i < n; i++ )
+    {
+        const int32_t x0 = cell_coord( aabbs[i].min.x ), x1 = cell_coord( aabbs[i].max.x ),
+                      y0 = cell_coord( aabbs[i].min.y ), y1 = cell_coord( aabbs[i].max.y );
+
+        if( (int64_t)x1 - x0 >= max_cells_per_axis ||
+            (int64_t)y1 - y0 >= max_cells_per_axis )
+        {
+            large.push_back( i );
+            continue;
+        }
+
+        for( int32_t y = y0; y <= y1; y++ )
+            for( int32_t x = x0; x <= x1; x++ )
+                entries.push_back( { x, y, i } );
+    }
+
+    // rozłóż wpisy do kubełków tablicy haszującej (sortowanie przez zliczanie)
+    uint32_t table_size = 1;
+    while( table_size < 2 * entries.size() )
+        table_size *= 2;
+
+    const uint32_t mask = table_size - 1;
+
+    bucket_start.assign( table_size + 1, 0 );
+    for( const Entry &e : entries )
+        bucket_start[ ( cell_hash( e.cx, e.cy ) & mask ) + 1 ]++;
+
+    for( uint32_t i = 0; i < table_size; i++ )
+        bucket_start[i + 1] += bucket_start[i];
+
+    buckets.resize( entries.size() );
+    for( const Entry &e : entries )
+        buckets[ bucket_start[ cell_hash( e.cx, e.cy ) & mask ]++ ] = e;
+
+    // po rozłożeniu bucket_start[i] wskazuje na koniec kubełka i,
+    // kubełki są sprawdzane równolegle, a pary łączone w kolejności kubełków
+    chunk_pairs.reset( JobSystem::chunk_count( table_size, bucket_grain ) );
+    thread_tests.reset( get_thread_count() );
+
+    parallel_for( jobs, table_size, bucket_grain, [&]( const JobRange &range )
+    {
+        std::vector<BodyPair> &out = chunk_pairs[range.chunk];
+        uint64_t tests = 0;
+
+        for( size_t b = range.begin; b < range.end; b++ )
+        {
+            const uint32_t begin = b == 0 ? 0 : bucket_start[b - 1],
+                           end = bucket_start[b];
+
+            for( uint32_t i = begin; i < end; i++ )
+            {
+                const Entry &e1 = buckets[i];
+
+                for( uint32_t j = i + 1; j < end; j++ )
+                {
+                    const Entry &e2 = buckets[j];
+
+                    // kolizja haszy
+                    if( e1.cx != e2.cx || e1.cy != e2.cy ) continue;
+
+                    const AABB &a = aabbs[e1.body], &c = aabbs[e2.body];
+                    tests++;
+                    if( !a.overlaps( c ) ) continue;
+
+                    // para dzieli wiele komórek - zgłoś ją tylko w komórce
+                    // zawierającej lewy dolny róg części wspólnej
+                    const glm::dvec2 corner = glm::max( a.min, c.min );
+                    if( cell_coord( corner.x ) != e1.cx ||
+                        cell_coord( corner.y ) != e1.cy )
+                        continue;
+
+                    out.emplace_back(
+                        std::min( e1.body, e2.body ), std::max( e1.body, e2.body ) );
+                }
+            }
+        }
+
+        thread_tests[range.thread] += tests;
+    } );
+
+    chunk_pairs.append_to( pairs );
+    aabb_tests = thread_tests.merged();
+
+    // duże obiekty sprawdź ze wszystkimi
+    if( !large.empty() )
+        all_aabbs.assign( aabbs );
+
+    for( size_t l = 0; l < large.size(); l++ )
+    {
+        const uint32_t i = large[l];
+
+        hits.clear();
+        find_overlaps( aabbs[i], all_aabbs, 0, n, hits );
+        aabb_tests += n;
+
+        for( const uint32_t j : hits )
+        {
+            if( j == i ) continue;
+
+            // para dwóch dużych obiektów zostanie zgłoszona raz
+            if( j < i && std::binary_search( large.begin(), large.end(), j ) )
+                continue;
+
+            pairs.emplace_back( std::min( i, j ), std::max( i, j ) );
+        }
+    }
+}
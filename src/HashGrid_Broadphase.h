@@ -0,0 +1,56 @@
+/*
+Jakub Janeczko
+nagłówek szerokiej fazy opartej na haszowanej siatce
+18.10.2026
+*/
+
+#pragma once
+
+#include "Broadphase.h"
+#include "AABBArray.h"
+
+#include <vector>
+#include <stdint.h>
+
+/**
+ * @brief szeroka faza oparta na jednorodnej siatce haszowanej po współrzędnych komórek
+ * 
+ * rozmiar komórki jest dobierany w każdym kroku na podstawie mediany rozmiarów AABB,
+ * dzięki czemu dla wielu obiektów podobnej wielkości znajdowanie par działa
+ * w czasie prawie liniowym
+ * 
+ * obiekty zajmujące zbyt wiele komórek (np. ściany areny) nie są wstawiane
+ * do siatki, tylko sprawdzane ze wszystkimi obiektami osobno
+ */
+class HashGrid_Broadphase : public IBroadphase {
+public:
+    virtual void find_pairs( const std::vector<AABB> &aabbs,
+        std::vector<BodyPair> &pairs );
+
+    double cell_size_factor = 2.0; ///< rozmiar komórki jako wielokrotność mediany rozmiaru AABB
+    int max_cells_per_axis = 4; ///< obiekty zajmujące więcej komórek na osi są sprawdzane osobno
+
+    /**
+     * @brief zwraca rozmiar komórki użyty w ostatnim wywołaniu find_pairs [m]
+     */
+    double get_cell_size() const { return cell_size; }
+
+private:
+    struct Entry {
+        int32_t cx, cy; ///< współrzędne komórki
+        uint32_t body; ///< indeks obiektu
+    };
+
+    double cell_size = 1.0;
+
+    std::vector<double> extents; ///< rozmiary AABB do wyznaczenia mediany
+    std::vector<Entry> entries; ///< pary komórka - obiekt
+    std::vector<Entry> buckets; ///< wpisy posortowane po kubełkach tablicy haszującej
+    std::vector<uint32_t> bucket_start; ///< początki kubełków w buckets
+    std::vector<uint32_t> large; ///< obiekty niewstawione do siatki
+    AABBArray all_aabbs; ///< AABB wszystkich obiektów do sprawdzania dużych obiektów
+    std::vector<uint32_t> hits; ///< obiekty przecinające AABB dużego obiektu
+    ChunkOutput<BodyPair> chunk_pairs; ///< pary znalezione w kolejnych fragmentach kubełków
+
+    int32_t cell_coord( double v ) const;
+};
@@ -0,0 +1,192 @@
+/*
+Jakub Janeczko
+jądro całkowania ruchu obiektów
+18.10.2026
+*/
+
+#include "Integration.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define PHYS2D_X86
+#include <immintrin.h>
+#endif
+
+// GCC i Clang kompilują funkcje AVX2 tylko gdy są oznaczone,
+// MSVC pozwala na użycie instrukcji bez dodatkowych flag
+#if defined(__GNUC__)
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE2
+#define TARGET_AVX2
+#endif
+
+// kolejność działań jest wspólna dla wszystkich wersji jądra, aby dawały
+// identyczne wyniki:
+//     v = (v + gravity_dv) * factor
+//     x = x + v * dt
+
+static void integrate_scalar( const IntegrationState &s, const IntegrationParams &p,
+    size_t begin )
+{
+    // wskaźniki w zmiennych lokalnych - zapisy do tablic nie muszą
+    // wtedy powodować ponownego odczytu struktury stanu
+    double *const x = s.x, *const y = s.y, *const angle = s.angle;
+    double *const vx = s.vx, *const vy = s.vy, *const w = s.w;
+    const uint32_t *const flags = s.flags;
+    const size_t count = s.count;
+
+    for( size_t i = begin; i < count; i++ )
+    {
+        // wybór wartości zamiast skoku, tak jak w wersjach wektorowych
+        const bool active = !( flags[i] & p.skip_flags );
+
+        const double new_vx = vx[i] * p.velocity_factor;
+        const double new_vy = ( vy[i] + p.gravity_dv ) * p.velocity_factor;
+        const double new_w = w[i] * p.angular_velocity_factor;
+
+        vx[i] = active ? new_vx : vx[i];
+        vy[i] = active ? new_vy : vy[i];
+        w[i] = active ? new_w : w[i];
+
+        x[i] = active ? x[i] + new_vx * p.dt : x[i];
+        y[i] = active ? y[i] + new_vy * p.dt : y[i];
+        angle[i] = active ? angle[i] + new_w * p.dt : angle[i];
+    }
+}
+
+#ifdef PHYS2D_X86
+
+// wybierz new tam gdzie maska jest ustawiona i old w p.p.
+TARGET_SSE2
+static inline __m128d select_sse2( __m128d mask, __m128d new_value, __m128d old_value )
+{
+    return _mm_or_pd( _mm_and_pd( mask, new_value ), _mm_andnot_pd( mask, old_value ) );
+}
+
+TARGET_SSE2
+static void integrate_sse2( const IntegrationState &s, const IntegrationParams &p )
+{
+    const __m128d gravity_dv = _mm_set1_pd( p.gravity_dv );
+    const __m128d velocity_factor = _mm_set1_pd( p.velocity_factor );
+    const __m128d angular_factor = _mm_set1_pd( p.angular_velocity_factor );
+    const __m128d dt = _mm_set1_pd( p.dt );
+    const __m128i skip_flags = _mm_set1_epi32( (int)p.skip_flags );
+    const __m128i zero = _mm_setzero_si128();
+
+    double *const x = s.x, *const y = s.y, *const angle = s.angle;
+    double *const vx = s.vx, *const vy = s.vy, *const w = s.w;
+    const uint32_t *const flags = s.flags;
+    const size_t count = s.count;
+
+    size_t i = 0;
+    for( ; i + 2 <= count; i += 2 )
+    {
+        // maska obiektów całkowanych: (flags & skip_flags) == 0,
+        // rozszerzona z 32 do 64 bitów na pasmo
+        const __m128i f = _mm_loadl_epi64( (const __m128i*)( flags + i ) );
+        const __m128i active32 = _mm_cmpeq_epi32( _mm_and_si128( f, skip_flags ), zero );
+        const __m128d active = _mm_castsi128_pd( _mm_unpacklo_epi32( active32, active32 ) );
+
+        const __m128d old_vx = _mm_loadu_pd( vx + i );
+        const __m128d old_vy = _mm_loadu_pd( vy + i );
+        const __m128d old_w = _mm_loadu_pd( w + i );
+
+        const __m128d new_vx = _mm_mul_pd( old_vx, velocity_factor );
+        const __m128d new_vy = _mm_mul_pd( _mm_add_pd( old_vy, gravity_dv ), velocity_factor );
+        const __m128d new_w = _mm_mul_pd( old_w, angular_factor );
+
+        _mm_storeu_pd( vx + i, select_sse2( active, new_vx, old_vx ) );
+        _mm_storeu_pd( vy + i, select_sse2( active, new_vy, old_vy ) );
+        _mm_storeu_pd( w + i, select_sse2( active, new_w, old_w ) );
+
+        const __m128d old_x = _mm_loadu_pd( x + i );
+        const __m128d old_y = _mm_loadu_pd( y + i );
+        const __m128d old_angle = _mm_loadu_pd( angle + i );
+
+        const __m128d new_x = _mm_add_pd( old_x, _mm_mul_pd( new_vx, dt ) );
+        const __m128d new_y = _mm_add_pd( old_y, _mm_mul_pd( new_vy, dt ) );
+        const __m128d new_angle = _mm_add_pd( old_angle, _mm_mul_pd( new_w, dt ) );
+
+        _mm_storeu_pd( x + i, select_sse2( active, new_x, old_x ) );
+        _mm_storeu_pd( y + i, select_sse2( active, new_y, old_y ) );
+        _mm_storeu_pd( angle + i, select_sse2( active, new_angle, old_angle ) );
+    }
+
+    integrate_scalar( s, p, i );
+}
+
+TARGET_AVX2
+static void integrate_avx2( const IntegrationState &s, const IntegrationParams &p )
+{
+    const __m256d gravity_dv = _mm256_set1_pd( p.gravity_dv );
+    const __m256d velocity_factor = _mm256_set1_pd( p.velocity_factor );
+    const __m256d angular_factor = _mm256_set1_pd( p.angular_velocity_factor );
+    const __m256d dt = _mm256_set1_pd( p.dt );
+    const __m128i skip_flags = _mm_set1_epi32( (int)p.skip_flags );
+    const __m128i zero = _mm_setzero_si128();
+
+    double *const x = s.x, *const y = s.y, *const angle = s.angle;
+    double *const vx = s.vx, *const vy = s.vy, *const w = s.w;
+    const uint32_t *const flags = s.flags;
+    const size_t count = s.count;
+
+    size_t i = 0;
+    for( ; i + 4 <= count; i += 4 )
+    {
+        const __m128i f = _mm_loadu_si128( (const __m128i*)( flags + i ) );
+        const __m128i active32 = _mm_cmpeq_epi32( _mm_and_si128( f, skip_flags ), zero );
+        const __m256d active = _mm256_castsi256_pd( _mm256_cvtepi32_epi64( active32 ) );
+
+        const __m256d old_vx = _mm256_loadu_pd( vx + i );
+        const __m256d old_vy = _mm256_loadu_pd( vy + i );
+        const __m256d old_w = _mm256_loadu_pd( w + i );
+
+        // mnożenie i dodawanie osobno (bez FMA) - tak samo jak w wersji skalarnej
+        const __m256d new_vx = _mm256_mul_pd( old_vx, velocity_factor );
+        const __m256d new_vy = _mm256_mul_pd( _mm256_add_pd( old_vy, gravity_dv ), velocity_factor );
+        const __m256d new_w = _mm256_mul_pd( old_w, angular_factor );
+
+        _mm256_storeu_pd( vx + i, _mm256_blendv_pd( old_vx, new_vx, active ) );
+        _mm256_storeu_pd( vy + i, _mm256_blendv_pd( old_vy, new_vy, active ) );
+        _mm256_storeu_pd( w + i, _mm256_blendv_pd( old_w, new_w, active ) );
+
+        const __m256d old_x = _mm256_loadu_pd( x + i );
+        const __m256d old_y = _mm256_loadu_pd( y + i );
+        const __m256d old_angle = _mm256_loadu_pd( angle + i );
+
+        const __m256d new_x = _mm256_add_pd( old_x, _mm256_mul_pd( new_vx, dt ) );
+        const __m256d new_y = _mm256_add_pd( old_y, _mm256_mul_pd( new_vy, dt ) );
+        const __m256d new_angle = _mm256_add_pd( old_angle, _mm256_mul_pd( new_w, dt ) );
+
+        _mm256_storeu_pd( x + i, _mm256_blendv_pd( old_x, new_x, active ) );
+        _mm256_storeu_pd( y + i, _mm256_blendv_pd( old_y, new_y, active ) );
+        _mm256_storeu_pd( angle + i, _mm256_blendv_pd( old_angle, new_angle, active ) );
+    }
+
+    integrate_scalar( s, p, i );
+}
+
+#endif
+
+void integrate_bodies( const IntegrationState &state, const IntegrationParams &params,
+    SimdLevel level )
+{
+#ifdef PHYS2D_X86
+    switch( level )
+    {
+    case SimdLevel::AVX2:
+        integrate_avx2( state, params );
+        return;
+    case SimdLevel::SSE2:
+        integrate_sse2( state, params );
+        return;
+    default:
+        break;
+    }
+#else
+    (void)level;
+#endif
+
+    integrate_scalar( state, params, 0 );
+}
@@ -0,0 +1,52 @@
+/*
+Jakub Janeczko
+nagłówek jądra całkowania ruchu obiektów
+18.10.2026
+*/
+
+#pragma once
+
+#include "CpuFeatures.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief tablice stanu obiektów na których działa całkowanie
+ * 
+ * tablice nie mogą na siebie nachodzić, wszystkie mają count elementów
+ */
+struct IntegrationState {
+    double *x, *y, *angle; ///< położenia i obroty
+    double *vx, *vy, *w; ///< prędkości liniowe i kątowe
+    const uint32_t *flags; ///< flagi obiektów
+    size_t count; ///< liczba obiektów
+};
+
+/**
+ * @brief parametry jednego kroku całkowania
+ */
+struct IntegrationParams {
+    double gravity_dv; ///< zmiana prędkości pionowej od grawitacji w kroku [m/s]
+    double velocity_factor; ///< mnożnik prędkości liniowej (tłumienie)
+    double angular_velocity_factor; ///< mnożnik prędkości kątowej (tłumienie)
+    double dt; ///< długość kroku [s]
+
+    /**
+     * @brief obiekty z którąkolwiek z tych flag nie są całkowane
+     */
+    uint32_t skip_flags;
+};
+
+/**
+ * @brief w jednym przejściu dodaje grawitację, tłumi prędkości
+ *        i przesuwa obiekty zgodnie z ich prędkościami
+ * 
+ * obiekty z flagami skip_flags są pomijane przez maskę (bez rozgałęzień),
+ * ich stan pozostaje bez zmian. Wynik jest identyczny dla każdego
+ * zestawu instrukcji
+ * 
+ * @param level zestaw instrukcji, domyślnie najlepszy dostępny
+ */
+void integrate_bodies( const IntegrationState &state, const IntegrationParams &params,
+    SimdLevel level = get_simd_level() );
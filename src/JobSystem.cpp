@@ -0,0 +1,206 @@
+/*
+Jakub Janeczko
+system zadań z podkradaniem pracy
+18.10.2026
+*/
+
+#include "JobSystem.h"
+#include "Profiler.h"
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <algorithm>
+
+bool JobSystem::TaskQueue::push( const Task &task )
+{
+    std::lock_guard<std::mutex> lock( mutex );
+
+    if( tail - head == capacity )
+        return false;
+
+    tasks[tail % capacity] = task;
+    tail++;
+    return true;
+}
+
+bool JobSystem::TaskQueue::pop( Task &task )
+{
+    std::lock_guard<std::mutex> lock( mutex );
+
+    if( head == tail )
+        return false;
+
+    tail--;
+    task = tasks[tail % capacity];
+    return true;
+}
+
+bool JobSystem::TaskQueue::steal( Task &task )
+{
+    std::lock_guard<std::mutex> lock( mutex );
+
+    if( head == tail )
+        return false;
+
+    task = tasks[head % capacity];
+    head++;
+    return true;
+}
+
+JobSystem::JobSystem( unsigned thread_count )
+{
+    start_workers( thread_count );
+}
+
+JobSystem::~JobSystem()
+{
+    stop_workers();
+}
+
+unsigned JobSystem::get_hardware_threads()
+{
+    return std::max( 1u, std::thread::hardware_concurrency() );
+}
+
+void JobSystem::set_thread_count( unsigned thread_count )
+{
+    if( thread_count == 0 )
+        thread_count = get_hardware_threads();
+
+    if( thread_count == get_thread_count() )
+        return;
+
+    stop_workers();
+    start_workers( thread_count );
+}
+
+void JobSystem::start_workers( unsigned thread_count )
+{
+    if( thread_count == 0 )
+        thread_count = get_hardware_threads();
+
+    stopping = false;
+
+    queues.clear();
+    for( unsigned t = 0; t < thread_count; t++ )
+        queues.push_back( std::make_unique<TaskQueue>() );
+
+    for( unsigned t = 1; t < thread_count; t++ )
+        workers.emplace_back( &JobSystem::worker_main, this, t );
+}
+
+void JobSystem::stop_workers()
+{
+    {
+        std::lock_guard<std::mutex> lock( wake_mutex );
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for( std::thread &worker : workers )
+        worker.join();
+
+    workers.clear();
+}
+
+void JobSystem::worker_main( unsigned thread )
+{
+    Profiler::set_thread_name( "job worker" );
+
+    uint64_t seen_generation = 0;
+
+    while( true )
+    {
+        Job *job;
+
+        {
+            std::unique_lock<std::mutex> lock( wake_mutex );
+            wake.wait( lock, [&]
+            {
+                return stopping || ( current_job && job_generation != seen_generation );
+            } );
+
+            if( stopping ) return;
+
+            job = current_job;
+            seen_generation = job_generation;
+
+            // dołączenie pod blokadą - run_job nie zakończy się dopóki
+            // wątek nie opuści pętli
+            busy_workers.fetch_add( 1, std::memory_order_relaxed );
+        }
+
+        while( job->remaining_chunks.load( std::memory_order_acquire ) > 0 )
+            if( !run_one( thread, *job ) )
+                std::this_thread::yield();
+
+        busy_workers.fetch_sub( 1, std::memory_order_release );
+    }
+}
+
+void JobSystem::run_job( Job &job )
+{
+    queues[0]->push( Task{ 0, chunk_count( job.count, job.grain ) } );
+
+    {
+        std::lock_guard<std::mutex> lock( wake_mutex );
+        current_job = &job;
+        job_generation++;
+    }
+    wake.notify_all();
+
+    while( job.remaining_chunks.load( std::memory_order_acquire ) > 0 )
+        if( !run_one( 0, job ) )
+            std::this_thread::yield();
+
+    {
+        std::lock_guard<std::mutex> lock( wake_mutex );
+        current_job = nullptr;
+    }
+
+    // job jest zmienną lokalną wywołującego - poczekaj aż wątki przestaną go używać
+    while( busy_workers.load( std::memory_order_acquire ) > 0 )
+        std::this_thread::yield();
+}
+
+bool JobSystem::run_one( unsigned thread, Job &job )
+{
+    Task task;
+
+    if( !queues[thread]->pop( task ) )
+    {
+        // podkradnij zadanie innemu wątkowi, zaczynając od następnego
+        const unsigned thread_count = get_thread_count();
+        bool found = false;
+
+        for( unsigned i = 1; i < thread_count && !found; i++ )
+            found = queues[( thread + i ) % thread_count]->steal( task );
+
+        if( !found ) return false;
+    }
+
+    // zostaw drugą połowę zadania do wzięcia przez siebie lub innych
+    while( task.last - task.first > 1 )
+    {
+        const size_t middle = task.first + ( task.last - task.first ) / 2;
+
+        if( !queues[thread]->push( Task{ middle, task.last } ) )
+            break;
+
+        task.last = middle;
+    }
+
+    PROFILE_ZONE( "parallel_for task" );
+
+    for( size_t c = task.first; c < task.last; c++ )
+    {
+        const JobRange range{ c * job.grain, std::min( job.count, ( c + 1 ) * job.grain ),
+            c, thread };
+        job.run( job.context, range );
+    }
+
+    job.remaining_chunks.fetch_sub( task.last - task.first, std::memory_order_acq_rel );
+    return true;
+}
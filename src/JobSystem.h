@@ -0,0 +1,272 @@
+/*
+Jakub Janeczko
+nagłówek systemu zadań z podkradaniem pracy
+18.10.2026
+*/
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief fragment zakresu przetwarzany przez jedno wywołanie ciała parallel_for
+ */
+struct JobRange {
+    size_t begin; ///< pierwszy indeks fragmentu
+    size_t end; ///< indeks za ostatnim elementem fragmentu
+    size_t chunk; ///< numer fragmentu, begin = chunk * grain
+    unsigned thread; ///< numer wątku wykonującego, 0 to wątek wywołujący
+};
+
+/**
+ * @brief stała pula wątków wykonująca pętle równoległe
+ *
+ * zakres pętli jest dzielony na fragmenty po grain elementów. Każdy wątek ma
+ * własną kolejkę dwustronną zadań (przedziałów fragmentów) - bierze zadania
+ * z jej końca, dzieląc je na pół dopóki zawierają więcej niż jeden fragment,
+ * a gdy jego kolejka jest pusta podkrada zadania z początku kolejek innych wątków
+ *
+ * podział na fragmenty zależy tylko od liczby elementów i grain, nie od liczby
+ * wątków - jeżeli wyniki fragmentów są łączone w kolejności ich numerów
+ * (np. przez ChunkOutput) to wynik nie zależy od liczby wątków
+ *
+ * wątek wywołujący parallel_for również wykonuje zadania. Pętle nie mogą być
+ * zagnieżdżane, a ciało pętli nie może rzucać wyjątków. Po uruchomieniu wątków
+ * parallel_for nie alokuje pamięci
+ */
+class JobSystem {
+public:
+    /**
+     * @param thread_count liczba wątków razem z wywołującym, 0 oznacza
+     *                     liczbę wątków sprzętowych
+     */
+    explicit JobSystem( unsigned thread_count = 1 );
+    ~JobSystem();
+
+    JobSystem( const JobSystem& ) = delete;
+    JobSystem &operator=( const JobSystem& ) = delete;
+
+    /**
+     * @brief zmienia liczbę wątków (razem z wywołującym), 0 oznacza
+     *        liczbę wątków sprzętowych
+     *
+     * nie może być wywołane w trakcie parallel_for
+     */
+    void set_thread_count( unsigned thread_count );
+
+    unsigned get_thread_count() const { return (unsigned)queues.size(); }
+
+    /**
+     * @brief zwraca liczbę wątków sprzętowych (przynajmniej 1)
+     */
+    static unsigned get_hardware_threads();
+
+    /**
+     * @brief zwraca liczbę fragmentów na które zostanie podzielone count elementów
+     */
+    static size_t chunk_count( size_t count, size_t grain )
+    {
+        return ( count + grain - 1 ) / grain;
+    }
+
+    /**
+     * @brief wywołuje body( const JobRange& ) dla fragmentów zakresu [0, count)
+     *        i czeka aż wszystkie zostaną przetworzone
+     *
+     * @param grain liczba elementów we fragmencie (> 0)
+     */
+    template<class F>
+    void parallel_for( size_t count, size_t grain, F &&body )
+    {
+        const size_t chunks = chunk_count( count, grain );
+
+        if( get_thread_count() == 1 || chunks <= 1 )
+        {
+            for( size_t c = 0; c < chunks; c++ )
+                body( JobRange{ c * grain, std::min( count, ( c + 1 ) * grain ), c, 0 } );
+            return;
+        }
+
+        Job job;
+        job.run = []( void *context, const JobRange &range )
+        {
+            ( *static_cast<std::remove_reference_t<F>*>( context ) )( range );
+        };
+        job.context = &body;
+        job.count = count;
+        job.grain = grain;
+        job.remaining_chunks.store( chunks, std::memory_order_relaxed );
+
+        run_job( job );
+    }
+
+private:
+    struct Job {
+        void (*run)( void *context, const JobRange &range ); ///< wywołuje ciało pętli
+        void *context; ///< ciało pętli
+        size_t count, grain;
+        std::atomic<size_t> remaining_chunks; ///< liczba nieprzetworzonych fragmentów
+    };
+
+    /**
+     * @brief przedział fragmentów [first, last) zadania
+     */
+    struct Task {
+        size_t first, last;
+    };
+
+    /**
+     * @brief kolejka dwustronna zadań jednego wątku o stałej pojemności
+     *
+     * przy dzieleniu zadań na pół kolejka zawiera najwyżej log2(liczba fragmentów)
+     * zadań, gdy jest pełna zadanie jest wykonywane bez dzielenia
+     */
+    class TaskQueue {
+    public:
+        bool push( const Task &task ); ///< dodaje na koniec (właściciel)
+        bool pop( Task &task ); ///< zdejmuje z końca (właściciel)
+        bool steal( Task &task ); ///< zdejmuje z początku (inne wątki)
+
+    private:
+        static constexpr size_t capacity = 64;
+
+        std::mutex mutex;
+        Task tasks[capacity];
+        size_t head = 0, tail = 0; ///< zadania są w [head, tail) modulo capacity
+    };
+
+    std::vector<std::unique_ptr<TaskQueue>> queues; ///< kolejka każdego wątku
+    std::vector<std::thread> workers; ///< wątki 1 .. n-1
+
+    std::mutex wake_mutex;
+    std::condition_variable wake;
+    Job *current_job = nullptr; ///< wykonywana pętla, chroniona przez wake_mutex
+    uint64_t job_generation = 0; ///< numer ostatnio rozpoczętej pętli
+    bool stopping = false; ///< wątki mają się zakończyć
+    std::atomic<unsigned> busy_workers{ 0 }; ///< wątki które pracują nad current_job
+
+    void start_workers( unsigned thread_count );
+    void stop_workers();
+    void worker_main( unsigned thread );
+
+    void run_job( Job &job );
+
+    // wykonuje jedno zadanie z własnej kolejki lub podkradzione,
+    // zwraca false gdy żadnego nie znaleziono
+    bool run_one( unsigned thread, Job &job );
+};
+
+/**
+ * @brief wywołuje jobs->parallel_for, a gdy jobs == nullptr
+ *        przetwarza fragmenty kolejno w wątku wywołującym
+ */
+template<class F>
+void parallel_for( JobSystem *jobs, size_t count, size_t grain, F &&body )
+{
+    if( jobs )
+    {
+        jobs->parallel_for( count, grain, std::forward<F>( body ) );
+        return;
+    }
+
+    const size_t chunks = JobSystem::chunk_count( count, grain );
+    for( size_t c = 0; c < chunks; c++ )
+        body( JobRange{ c * grain, std::min( count, ( c + 1 ) * grain ), c, 0 } );
+}
+
+/**
+ * @brief osobne wyjście każdego fragmentu pętli równoległej
+ *
+ * fragmenty dopisują wyniki do własnych tablic, które są na końcu łączone
+ * w kolejności fragmentów - wynik jest taki sam jak w pętli sekwencyjnej.
+ * Tablice są zachowywane pomiędzy krokami, więc w stanie ustalonym
+ * nie alokuje pamięci
+ */
+template<class T>
+class ChunkOutput {
+public:
+    /**
+     * @brief przygotowuje puste wyjścia dla chunk_count fragmentów
+     */
+    void reset( size_t chunk_count )
+    {
+        if( chunks.size() < chunk_count )
+            chunks.resize( chunk_count );
+
+        used = chunk_count;
+        for( size_t c = 0; c < used; c++ )
+            chunks[c].clear();
+    }
+
+    std::vector<T> &operator[]( size_t chunk ) { return chunks[chunk]; }
+
+    /**
+     * @brief dopisuje wyniki wszystkich fragmentów do out w kolejności fragmentów
+     */
+    void append_to( std::vector<T> &out ) const
+    {
+        for( size_t c = 0; c < used; c++ )
+            out.insert( out.end(), chunks[c].begin(), chunks[c].end() );
+    }
+
+private:
+    std::vector<std::vector<T>> chunks;
+    size_t used = 0;
+};
+
+/**
+ * @brief osobna wartość dla każdego wątku pętli równoległej (np. liczniki)
+ *
+ * wątki zmieniają tylko własną wartość (JobRange::thread), a po pętli
+ * wartości są sumowane. Każda wartość zajmuje osobną linię pamięci
+ * podręcznej, więc wątki nie spowalniają się nawzajem
+ *
+ * @tparam T typ z operatorem +=, T{} to wartość zerowa
+ */
+template<class T>
+class PerThread {
+public:
+    /**
+     * @brief zeruje wartości dla thread_count wątków
+     */
+    void reset( unsigned thread_count )
+    {
+        if( slots.size() < thread_count )
+            slots.resize( thread_count );
+
+        used = thread_count;
+        for( unsigned t = 0; t < used; t++ )
+            slots[t].value = T{};
+    }
+
+    T &operator[]( unsigned thread ) { return slots[thread].value; }
+
+    /**
+     * @brief zwraca sumę wartości wszystkich wątków
+     */
+    T merged() const
+    {
+        T sum{};
+        for( unsigned t = 0; t < used; t++ )
+            sum += slots[t].value;
+        return sum;
+    }
+
+private:
+    struct alignas(64) Slot {
+        T value{};
+    };
+
+    std::vector<Slot> slots;
+    unsigned used = 0;
+};
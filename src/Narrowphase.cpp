@@ -0,0 +1,612 @@
+/*
+Jakub Janeczko
+wąska faza wykrywania kolizji
+18.10.2026
+*/
+
+#include "Narrowphase.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+// znajdź wierzchołek najdalej w kierunku dir wspinając się po otoczce od start
+// (dla wypukłego wielokąta lokalne maksimum jest globalne)
+static uint32_t find_support( const std::vector<glm::dvec2> &points,
+    const glm::dvec2 &dir, uint32_t start )
+{
+    const uint32_t n = (uint32_t)points.size();
+
+    uint32_t best = start;
+    double best_dot = glm::dot( points[best], dir );
+
+    bool moved = false;
+
+    while( true )
+    {
+        const uint32_t next = best + 1 == n ? 0 : best + 1;
+        const double next_dot = glm::dot( points[next], dir );
+
+        if( next_dot <= best_dot ) break;
+
+        best = next;
+        best_dot = next_dot;
+        moved = true;
+    }
+
+    if( moved ) return best;
+
+    while( true )
+    {
+        const uint32_t prev = best == 0 ? n - 1 : best - 1;
+        const double prev_dot = glm::dot( points[prev], dir );
+
+        if( prev_dot <= best_dot ) break;
+
+        best = prev;
+        best_dot = prev_dot;
+    }
+
+    return best;
+}
+
+// krawędź odniesienia obiektu b jest wybierana zamiast krawędzi obiektu a
+// tylko gdy jej oś ma wyraźnie mniejsze przenikanie - zapobiega zmianom
+// krawędzi pomiędzy krokami (tolerancja względna i bezwzględna [m])
+constexpr double reference_relative_tolerance = 0.98;
+constexpr double reference_absolute_tolerance = 1e-3;
+
+// czy oś b o odległości sep_b jest lepszą osią odniesienia niż oś a o sep_a
+static bool prefer_reference_b( double sep_a, double sep_b )
+{
+    return sep_b > reference_relative_tolerance * sep_a + reference_absolute_tolerance;
+}
+
+// odległość ze znakiem najgłębszego punktu b od krawędzi edge obiektu a
+static double edge_separation( const Polygon &a, const Polygon &b,
+    uint32_t edge, uint32_t &support )
+{
+    const glm::dvec2 &n = a.normals[edge];
+    const glm::dvec2 offset = b.center - a.center;
+
+    support = find_support( b.points, -n, support );
+
+    return glm::dot( b.points[support] + offset - a.points[edge], n );
+}
+
+// identyfikator punktu kontaktu (zobacz ContactPoint::id)
+static uint64_t contact_id( bool flip, uint32_t ref_edge, uint32_t inc_vertex )
+{
+    return (uint64_t)flip << 63 | (uint64_t)ref_edge << 32 | inc_vertex;
+}
+
+namespace {
+
+// punkt obcinanego odcinka
+struct ClipVertex {
+    glm::dvec2 p;
+    uint32_t vertex; ///< wierzchołek obiektu incydentnego z którego pochodzi punkt
+};
+
+}
+
+// obcina odcinek do półpłaszczyzny dot(dir, p) <= offset
+static int clip_segment( ClipVertex *v, const glm::dvec2 &dir, double offset )
+{
+    const double d0 = glm::dot( dir, v[0].p ) - offset;
+    const double d1 = glm::dot( dir, v[1].p ) - offset;
+
+    ClipVertex out[2];
+    int count = 0;
+
+    if( d0 <= 0 ) out[count++] = v[0];
+    if( d1 <= 0 ) out[count++] = v[1];
+
+    // końce po przeciwnych stronach - dodaj punkt przecięcia
+    if( d0 * d1 < 0 )
+    {
+        const double t = d0 / ( d0 - d1 );
+        out[count++] = ClipVertex{
+            v[0].p + t * ( v[1].p - v[0].p ),
+            d0 > 0 ? v[0].vertex : v[1].vertex
+        };
+    }
+
+    v[0] = out[0];
+    v[1] = out[1];
+
+    return count;
+}
+
+// obcina krawędź incydentną inc do krawędzi ref_edge obiektu ref
+// flip oznacza, że obiektem odniesienia jest b
+// zwraca false gdy krawędź incydentna leży poza pasem krawędzi odniesienia
+static bool clip_manifold( const Polygon &ref, const Polygon &inc,
+    uint32_t ref_edge, bool flip, Manifold &manifold )
+{
+    const std::vector<glm::dvec2> &ref_points = ref.points;
+    const std::vector<glm::dvec2> &inc_points = inc.points;
+
+    const uint32_t ref_n = (uint32_t)ref_points.size();
+    const uint32_t inc_n = (uint32_t)inc_points.size();
+
+    const glm::dvec2 n = ref.normals[ref_edge];
+    const glm::dvec2 v1 = ref.center + ref_points[ref_edge];
+    const glm::dvec2 v2 = ref.center + ref_points[ref_edge + 1 == ref_n ? 0 : ref_edge + 1];
+
+    // krawędź incydentna - najbardziej przeciwna do krawędzi odniesienia
+    const uint32_t i1 = find_support( inc.normals, -n, 0 );
+    const uint32_t i2 = i1 + 1 == inc_n ? 0 : i1 + 1;
+
+    ClipVertex clip[2] = {
+        { inc.center + inc_points[i1], i1 },
+        { inc.center + inc_points[i2], i2 }
+    };
+
+    // obetnij do pasa wyznaczonego przez boki krawędzi odniesienia
+    const glm::dvec2 t = glm::normalize( v2 - v1 );
+
+    if( clip_segment( clip, -t, -glm::dot( t, v1 ) ) < 2 ) return false;
+    if( clip_segment( clip,  t,  glm::dot( t, v2 ) ) < 2 ) return false;
+
+    // zostaw tylko punkty za krawędzią odniesienia
+    manifold.normal = flip ? -n : n;
+    manifold.count = 0;
+
+    for( const ClipVertex &cv : clip )
+    {
+        const double separation = glm::dot( cv.p - v1, n );
+        if( separation > 0 ) continue;
+
+        manifold.points[manifold.count++] = ContactPoint{
+            cv.p,
+            -separation,
+            contact_id( flip, ref_edge, cv.vertex )
+        };
+    }
+
+    return manifold.count > 0;
+}
+
+// kontakt w jednym punkcie - najgłębszym wierzchołku inc za krawędzią ref_edge
+static bool deepest_vertex_manifold( const Polygon &ref, const Polygon &inc,
+    uint32_t ref_edge, bool flip, Manifold &manifold )
+{
+    const glm::dvec2 n = ref.normals[ref_edge];
+
+    uint32_t vertex = 0;
+    const double separation = edge_separation( ref, inc, ref_edge, vertex );
+
+    if( separation > 0 ) return false;
+
+    manifold.normal = flip ? -n : n;
+    manifold.count = 1;
+    manifold.points[0] = ContactPoint{
+        inc.center + inc.points[vertex],
+        -separation,
+        contact_id( flip, ref_edge, vertex )
+    };
+
+    return true;
+}
+
+// wyznacza kontakt z krawędzią odniesienia obiektu o lepszej osi, a gdy
+// obcięcie się nie uda - z krawędzią drugiego obiektu, w ostateczności
+// w najgłębszym wierzchołku, by przenikające się obiekty zawsze miały kontakt
+static bool clip_best_reference( const Polygon &a, const Polygon &b,
+    uint32_t edge_a, double sep_a, uint32_t edge_b, double sep_b, Manifold &manifold )
+{
+    if( prefer_reference_b( sep_a, sep_b ) )
+        return clip_manifold( b, a, edge_b, true, manifold ) ||
+            clip_manifold( a, b, edge_a, false, manifold ) ||
+            deepest_vertex_manifold( b, a, edge_b, true, manifold );
+    else
+        return clip_manifold( a, b, edge_a, false, manifold ) ||
+            clip_manifold( b, a, edge_b, true, manifold ) ||
+            deepest_vertex_manifold( a, b, edge_a, false, manifold );
+}
+
+bool build_manifold( const Polygon &a, const Polygon &b,
+    const glm::dvec2 &normal, Manifold &manifold )
+{
+    // kandydaci - krawędzie obu obiektów najbardziej zgodne z normalną
+    const uint32_t edge_a = find_support( a.normals, normal, 0 );
+    const uint32_t edge_b = find_support( b.normals, -normal, 0 );
+
+    // wybór jak w SAT - oś z mniejszym przenikaniem
+    uint32_t support_b = 0, support_a = 0;
+    const double sep_a = edge_separation( a, b, edge_a, support_b );
+    const double sep_b = edge_separation( b, a, edge_b, support_a );
+
+    return clip_best_reference( a, b, edge_a, sep_a, edge_b, sep_b, manifold );
+}
+
+// znajdź parę krawęź a - punkt b które są najbliżej
+// czyli najkrótszą drogę by rozdzielić obiekt a od b
+// po krawędzi a 
+// (korzysta bezpośrednio z obróconych punktów obiektów, bez alokacji pamięci)
+std::pair<Edge,glm::dvec2> get_shortest_edge_point_dist( 
+    const Polygon &a,
+    const Polygon &b )
+{
+    const std::vector<glm::dvec2> &points_a = a.points;
+    const std::vector<glm::dvec2> &points_b = b.points;
+
+    const double inf = std::numeric_limits<double>::infinity();
+
+    Edge edge{};
+    glm::dvec2 pt{};
+    double edge_dist = -inf;
+
+    size_t prev = points_a.size() - 1;
+    for( size_t i = 0; i < points_a.size(); prev = i++ )
+    {
+        const Edge new_edge{ points_a[prev] + a.center, points_a[i] + a.center };
+        const glm::dvec2 normal = new_edge.get_normal();
+
+        // punkt b najbardziej za krawędzią
+        glm::dvec2 new_pt{};
+        double new_dist = inf;
+
+        for( const glm::dvec2 &p : points_b )
+        {
+            const glm::dvec2 world_p = p + b.center;
+            const double dist = glm::dot( world_p - new_edge.a, normal );
+
+            if( dist < new_dist )
+            {
+                new_dist = dist;
+                new_pt = world_p;
+            }
+        }
+
+        if( new_dist > edge_dist )
+        {
+            edge = new_edge;
+            pt = new_pt;
+            edge_dist = new_dist;
+        }
+    }
+
+    return {edge, pt};
+}
+
+bool collide_edge_point( const Polygon &a, const Polygon &b,
+    Manifold &manifold )
+{
+    // znajdź najkrótrzy wektor rozdzielający obiekty
+    auto [e_a, p_b] = get_shortest_edge_point_dist(a, b);
+    auto [e_b, p_a] = get_shortest_edge_point_dist(b, a);
+    
+    double d1 = e_a.signed_distance(p_b);
+    double d2 = e_b.signed_distance(p_a);
+
+    // obiekty nie nachodzą na siebie
+    if( d1 > 0 || d2 > 0 ) return false;
+
+    // normalna krawędzi a jest skierowana od a do b, a krawędzi b - od b do a
+    const glm::dvec2 normal = d1 > d2 ? e_a.get_normal() : -e_b.get_normal();
+
+    return build_manifold( a, b, normal, manifold );
+}
+
+// największa odległość krawędzi a od b
+// kończy się na pierwszej krawędzi rozdzielającej obiekty
+static double max_separation( const Polygon &a, const Polygon &b,
+    uint32_t &best_edge, uint32_t &best_support )
+{
+    const uint32_t n = (uint32_t)a.points.size();
+
+    double best = -std::numeric_limits<double>::infinity();
+    uint32_t support = 0;
+
+    for( uint32_t i = 0; i < n; i++ )
+    {
+        // kolejne normalne obracają się w jedną stronę, więc najgłębszy
+        // punkt b też - wystarczy przesunąć go od poprzedniego
+        const double sep = edge_separation( a, b, i, support );
+
+        if( sep > best )
+        {
+            best = sep;
+            best_edge = i;
+            best_support = support;
+
+            if( sep > 0 ) break;
+        }
+    }
+
+    return best;
+}
+
+bool collide_sat( const Polygon &a, const Polygon &b,
+    SATCache &cache, Manifold &manifold )
+{
+    // najpierw sprawdź oś która była ostatnio wybrana
+    if( cache.valid )
+    {
+        const Polygon &ref = cache.body ? b : a,
+                            &inc = cache.body ? a : b;
+
+        uint32_t support = 0;
+
+        if( cache.edge < ref.points.size() &&
+            edge_separation( ref, inc, cache.edge, support ) > 0 )
+            return false;
+    }
+
+    uint32_t edge_a = 0, support_b = 0;
+    const double sep_a = max_separation( a, b, edge_a, support_b );
+
+    if( sep_a > 0 )
+    {
+        cache = SATCache{ edge_a, 0, true };
+        return false;
+    }
+
+    uint32_t edge_b = 0, support_a = 0;
+    const double sep_b = max_separation( b, a, edge_b, support_a );
+
+    if( sep_b > 0 )
+    {
+        cache = SATCache{ edge_b, 1, true };
+        return false;
+    }
+
+    // obiekty się przenikają - rozdziel je po osi z najmniejszym przenikaniem
+    if( prefer_reference_b( sep_a, sep_b ) )
+        cache = SATCache{ edge_b, 1, true };
+    else
+        cache = SATCache{ edge_a, 0, true };
+
+    return clip_best_reference( a, b, edge_a, sep_a, edge_b, sep_b, manifold );
+}
+
+namespace {
+
+// wierzchołek różnicy Minkowskiego a - b
+struct MinkowskiVertex {
+    glm::dvec2 w; ///< punkt a - punkt b (względem środka a)
+    uint32_t ia, ib; ///< indeksy wierzchołków a i b
+};
+
+// wyznacza punkty podparcia różnicy Minkowskiego a - b
+class MinkowskiDifference {
+public:
+    MinkowskiDifference( const Polygon &a, const Polygon &b )
+        : points_a( a.points )
+        , points_b( b.points )
+        , offset( b.center - a.center ) {}
+
+    MinkowskiVertex support( const glm::dvec2 &dir )
+    {
+        last_a = find_support( points_a, dir, last_a );
+        last_b = find_support( points_b, -dir, last_b );
+
+        return vertex( last_a, last_b );
+    }
+
+    MinkowskiVertex vertex( uint32_t ia, uint32_t ib ) const
+    {
+        return MinkowskiVertex{ points_a[ia] - points_b[ib] - offset, ia, ib };
+    }
+
+    const std::vector<glm::dvec2> &points_a, &points_b;
+    const glm::dvec2 offset;
+
+private:
+    uint32_t last_a = 0, last_b = 0;
+};
+
+}
+
+// redukuje sympleks do najmniejszego podsympleksu zawierającego punkt
+// najbliższy początkowi układu i zwraca ten punkt
+// count == 3 po wywołaniu oznacza, że początek układu jest w trójkącie
+static glm::dvec2 solve_simplex( MinkowskiVertex *v, int &count )
+{
+    if( count == 1 )
+        return v[0].w;
+
+    if( count == 2 )
+    {
+        const glm::dvec2 &w1 = v[0].w, &w2 = v[1].w;
+        const glm::dvec2 e12 = w2 - w1;
+
+        // współrzędne barycentryczne punktu najbliższego początkowi
+        const double d12_1 = glm::dot( w2, e12 );
+        const double d12_2 = -glm::dot( w1, e12 );
+
+        if( d12_2 <= 0 )
+        {
+            count = 1;
+            return w1;
+        }
+
+        if( d12_1 <= 0 )
+        {
+            v[0] = v[1];
+            count = 1;
+            return w2;
+        }
+
+        return ( w1 * d12_1 + w2 * d12_2 ) / ( d12_1 + d12_2 );
+    }
+
+    const glm::dvec2 &w1 = v[0].w, &w2 = v[1].w, &w3 = v[2].w;
+
+    const glm::dvec2 e12 = w2 - w1, e13 = w3 - w1, e23 = w3 - w2;
+
+    const double d12_1 = glm::dot( w2, e12 ), d12_2 = -glm::dot( w1, e12 );
+    const double d13_1 = glm::dot( w3, e13 ), d13_2 = -glm::dot( w1, e13 );
+    const double d23_1 = glm::dot( w3, e23 ), d23_2 = -glm::dot( w2, e23 );
+
+    const double n123 = vec_cross( e12, e13 );
+
+    const double d123_1 = n123 * vec_cross( w2, w3 );
+    const double d123_2 = n123 * vec_cross( w3, w1 );
+    const double d123_3 = n123 * vec_cross( w1, w2 );
+
+    const auto keep = [&]( int i, int j )
+    {
+        const MinkowskiVertex vi = v[i], vj = v[j];
+        v[0] = vi;
+        v[1] = vj;
+        count = 2;
+
+        return solve_simplex( v, count );
+    };
+
+    // obszar wierzchołka w1
+    if( d12_2 <= 0 && d13_2 <= 0 )
+    {
+        count = 1;
+        return w1;
+    }
+
+    // obszar krawędzi w1-w2
+    if( d12_1 > 0 && d12_2 > 0 && d123_3 <= 0 )
+        return keep( 0, 1 );
+
+    // obszar krawędzi w1-w3
+    if( d13_1 > 0 && d13_2 > 0 && d123_2 <= 0 )
+        return keep( 0, 2 );
+
+    // obszar wierzchołka w2
+    if( d12_1 <= 0 && d23_2 <= 0 )
+    {
+        v[0] = v[1];
+        count = 1;
+        return v[0].w;
+    }
+
+    // obszar wierzchołka w3
+    if( d13_1 <= 0 && d23_1 <= 0 )
+    {
+        v[0] = v[2];
+        count = 1;
+        return v[0].w;
+    }
+
+    // obszar krawędzi w2-w3
+    if( d23_1 > 0 && d23_2 > 0 && d123_1 <= 0 )
+        return keep( 1, 2 );
+
+    // początek układu jest wewnątrz trójkąta
+    return glm::dvec2( 0.0 );
+}
+
+bool collide_gjk_epa( const Polygon &a, const Polygon &b,
+    Manifold &manifold )
+{
+    constexpr int max_gjk_iterations = 64;
+    constexpr int max_polytope = 256;
+    constexpr double tolerance = 1e-10;
+
+    MinkowskiDifference md( a, b );
+
+    // GJK - szukaj punktu różnicy Minkowskiego najbliższego początkowi układu
+    MinkowskiVertex simplex[3];
+    int count = 1;
+
+    simplex[0] = md.support( md.offset );
+
+    bool contains_origin = false;
+
+    for( int it = 0; it < max_gjk_iterations; it++ )
+    {
+        const glm::dvec2 closest = solve_simplex( simplex, count );
+
+        if( count == 3 )
+        {
+            contains_origin = true;
+            break;
+        }
+
+        const double dist2 = glm::dot( closest, closest );
+
+        // obiekty się stykają - nie ma czego rozdzielać
+        if( dist2 < tolerance * tolerance )
+            return false;
+
+        const glm::dvec2 dir = -closest;
+        const MinkowskiVertex w = md.support( dir );
+
+        // punkt podparcia nie przybliża do początku układu - obiekty są rozdzielone
+        if( glm::dot( w.w - closest, dir ) <= tolerance * dist2 )
+            return false;
+
+        bool duplicate = false;
+        for( int i = 0; i < count; i++ )
+            duplicate |= simplex[i].ia == w.ia && simplex[i].ib == w.ib;
+
+        if( duplicate )
+            return false;
+
+        simplex[count++] = w;
+    }
+
+    if( !contains_origin )
+        return false;
+
+    // EPA - rozszerzaj wielokąt zawarty w różnicy Minkowskiego aż do jej brzegu
+    MinkowskiVertex polytope[max_polytope];
+    int size = 3;
+
+    polytope[0] = simplex[0];
+    polytope[1] = simplex[1];
+    polytope[2] = simplex[2];
+
+    // zapewnij kolejność odwrotną do ruchu wskazówek zegara
+    if( vec_cross( polytope[1].w - polytope[0].w, polytope[2].w - polytope[0].w ) < 0 )
+        std::swap( polytope[1], polytope[2] );
+
+    int best_edge = 0;
+    glm::dvec2 best_normal( 0.0 );
+    double best_dist = 0.0;
+
+    while( true )
+    {
+        // znajdź krawędź najbliższą początkowi układu
+        best_dist = std::numeric_limits<double>::infinity();
+
+        for( int i = 0; i < size; i++ )
+        {
+            const int j = i + 1 == size ? 0 : i + 1;
+            const glm::dvec2 e = polytope[j].w - polytope[i].w;
+            const double len = glm::length( e );
+
+            if( len < tolerance ) continue;
+
+            // normalna zewnętrzna
+            const glm::dvec2 n = glm::dvec2( e.y, -e.x ) / len;
+            const double dist = glm::dot( n, polytope[i].w );
+
+            if( dist < best_dist )
+            {
+                best_dist = dist;
+                best_normal = n;
+                best_edge = i;
+            }
+        }
+
+        const MinkowskiVertex w = md.support( best_normal );
+
+        // krawędź leży na brzegu różnicy Minkowskiego
+        if( glm::dot( w.w, best_normal ) - best_dist <= tolerance * ( 1.0 + best_dist ) ||
+            size == max_polytope )
+            break;
+
+        // wstaw nowy wierzchołek pomiędzy końce krawędzi
+        for( int i = size; i > best_edge + 1; i-- )
+            polytope[i] = polytope[i - 1];
+
+        polytope[best_edge + 1] = w;
+        size++;
+    }
+
+    // przesunięcie b o best_dist w kierunku normalnej rozdziela obiekty
+    return build_manifold( a, b, best_normal, manifold );
+}
@@ -0,0 +1,139 @@
+/*
+Jakub Janeczko
+nagłówek wąskiej fazy wykrywania kolizji
+18.10.2026
+*/
+
+#pragma once
+
+#include "Shape.h"
+
+#include <glm/glm.hpp>
+
+#include <utility>
+#include <stdint.h>
+
+/**
+ * @brief punkt kontaktu pomiędzy dwoma obiektami
+ */
+struct ContactPoint {
+    glm::dvec2 point; ///< punkt kontaktu na obiekcie incydentnym [m]
+    double depth; ///< głębokość przenikania w tym punkcie [m]
+
+    /**
+     * @brief identyfikator cech obiektów tworzących punkt
+     * 
+     * składa się z tego, który obiekt jest obiektem odniesienia (bit 63),
+     * krawędzi odniesienia (bity 32-62) i wierzchołka obiektu incydentnego
+     * (bity 0-31) - ten sam punkt w kolejnych krokach ma ten sam identyfikator
+     *
+     * pola nie nachodzą na siebie dla kształtów do max_shape_vertices wierzchołków
+     */
+    uint64_t id;
+
+    /**
+     * @brief skumulowany impuls normalny w tym punkcie [kg*m/s]
+     * 
+     * wąska faza ustawia go na 0, a silnik przenosi go pomiędzy krokami
+     * dla punktów o tym samym identyfikatorze
+     */
+    double normal_impulse = 0.0;
+};
+
+/**
+ * @brief rozmaitość kontaktu - kontakt pomiędzy dwoma obiektami
+ *        znaleziony przez wąską fazę
+ * 
+ * zawiera do dwóch punktów: gdy krawędzie obiektów leżą na sobie
+ * kontakt jest opisany przez oba końce ich części wspólnej
+ */
+struct Manifold {
+    glm::dvec2 normal; ///< normalna kontaktu, skierowana od obiektu a do obiektu b
+    ContactPoint points[2]; ///< punkty kontaktu
+    int count = 0; ///< liczba punktów kontaktu (0, 1 lub 2)
+};
+
+/**
+ * @brief oś rozdzielająca zapamiętana dla pary obiektów pomiędzy krokami
+ * 
+ * większość par z szerokiej fazy jest rozdzielona tą samą osią co
+ * w poprzednim kroku, więc sprawdzenie jej jako pierwszej pozwala
+ * zakończyć test po jednej osi
+ */
+struct SATCache {
+    uint32_t edge = 0; ///< indeks krawędzi wyznaczającej oś
+    uint8_t body = 0; ///< 0 jeżeli krawędź należy do obiektu a, 1 jeżeli do b
+    bool valid = false; ///< czy oś została już wyznaczona
+};
+
+/**
+ * @brief znajduje parę krawędź a - punkt b które są najbliżej
+ * 
+ * czyli najkrótszą drogę by rozdzielić obiekt a od b po krawędzi a
+ * (sprawdza wszystkie krawędzie a ze wszystkimi punktami b)
+ * 
+ * @return para krawędź a i najgłębszy względem niej punkt b
+ */
+std::pair<Edge,glm::dvec2> get_shortest_edge_point_dist(
+    const Polygon &a,
+    const Polygon &b );
+
+/**
+ * @brief wyznacza punkty kontaktu obcinając krawędź incydentną
+ *        do krawędzi odniesienia
+ * 
+ * kandydatami są krawędzie obu obiektów najbardziej zgodne z normalną,
+ * odniesieniem jest ta, wzdłuż której normalnej przenikanie jest mniejsze
+ * (tak jak w SAT), a incydentną krawędź drugiego obiektu najbardziej jej
+ * przeciwna. Gdy krawędź incydentna leży poza krawędzią odniesienia
+ * odniesieniem jest krawędź drugiego obiektu, a w ostateczności kontakt
+ * ma jeden punkt w najgłębszym wierzchołku
+ * 
+ * @param normal normalna kontaktu, skierowana od a do b
+ * @param manifold wyjście
+ * @return true jeżeli znaleziono co najmniej jeden punkt kontaktu
+ */
+bool build_manifold( const Polygon &a, const Polygon &b,
+    const glm::dvec2 &normal, Manifold &manifold );
+
+/**
+ * @brief sprawdza kolizję porównując każdą krawędź z każdym punktem
+ * 
+ * @param manifold wyjście, wypełniane jeżeli obiekty kolidują
+ * @return true jeżeli obiekty się przenikają
+ */
+bool collide_edge_point( const Polygon &a, const Polygon &b,
+    Manifold &manifold );
+
+/**
+ * @brief sprawdza kolizję twierdzeniem o osi rozdzielającej (SAT)
+ * 
+ * osiami są normalne krawędzi obu obiektów, dla każdej osi najgłębszy
+ * punkt drugiego obiektu jest znajdowany wspinaczką po otoczce zaczynając
+ * od wyniku dla poprzedniej krawędzi, a test kończy się na pierwszej
+ * osi rozdzielającej
+ * 
+ * @param cache oś rozdzielająca tej pary z poprzedniego kroku, zostaje zaktualizowana
+ * @param manifold wyjście, wypełniane jeżeli obiekty kolidują
+ * @return true jeżeli obiekty się przenikają
+ */
+bool collide_sat( const Polygon &a, const Polygon &b,
+    SATCache &cache, Manifold &manifold );
+
+/**
+ * @brief sprawdza kolizję algorytmami GJK i EPA
+ * 
+ * GJK szuka punktu różnicy Minkowskiego obiektów najbliższego początkowi
+ * układu współrzędnych - jeżeli obiekty są rozdzielone kończy się bez
+ * dalszych obliczeń, w przeciwnym razie EPA rozszerza końcowy sympleks
+ * GJK do krawędzi różnicy Minkowskiego najbliższej początkowi układu,
+ * wyznaczając normalną i głębokość przenikania
+ * 
+ * punkty podparcia są znajdowane wspinaczką po otoczce zaczynając od
+ * poprzednio znalezionych, więc koszt rośnie wolno z liczbą wierzchołków
+ * 
+ * @param manifold wyjście, wypełniane jeżeli obiekty kolidują
+ * @return true jeżeli obiekty się przenikają
+ */
+bool collide_gjk_epa( const Polygon &a, const Polygon &b,
+    Manifold &manifold );
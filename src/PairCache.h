@@ -0,0 +1,151 @@
+/*
+Jakub Janeczko
+pamięć danych par obiektów pomiędzy krokami symulacji
+18.10.2026
+*/
+
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <stdint.h>
+
+/**
+ * @brief dane przypisane parom obiektów, pamiętane pomiędzy kolejnymi krokami
+ * 
+ * na początku każdego kroku należy wywołać begin_frame, a następnie get dla
+ * każdej aktywnej pary - get zwraca dane z poprzedniego kroku lub T{} dla nowej
+ * pary, a pary o które nie zapytano zostają zapomniane
+ * 
+ * przechowuje dwie tablice haszujące z adresowaniem otwartym (poprzednią i obecną)
+ * więc po osiągnięciu docelowego rozmiaru nie alokuje pamięci
+ * 
+ * @tparam T typ danych pary
+ */
+template<class T>
+class PairCache {
+public:
+    /**
+     * @brief rozpoczyna nowy krok
+     * 
+     * @param expected_pairs spodziewana liczba par w tym kroku
+     */
+    void begin_frame( size_t expected_pairs )
+    {
+        std::swap( previous, current );
+        current.reset( expected_pairs );
+    }
+
+    /**
+     * @brief zwraca dane pary (a, b) w obecnym kroku
+     * 
+     * referencja jest ważna do następnego wywołania get lub begin_frame - jeżeli
+     * w kroku zostanie pobranych najwyżej expected_pairs par, tablica nie rośnie
+     * i wszystkie referencje są ważne do następnego begin_frame
+     * 
+     * @param found ustawiany na true jeżeli para istniała w poprzednim kroku
+     */
+    T &get( uint32_t a, uint32_t b, bool *found = nullptr )
+    {
+        const uint64_t key = (uint64_t)a << 32 | b;
+
+        if( T *value = current.find( key ) )
+        {
+            if( found ) *found = true;
+            return *value;
+        }
+
+        const T *old = previous.find( key );
+        if( found ) *found = old != nullptr;
+
+        return current.insert( key, old ? *old : T{} );
+    }
+
+    /**
+     * @brief zwraca liczbę par w obecnym kroku
+     */
+    size_t size() const { return current.count; }
+
+    /**
+     * @brief zapomina wszystkie pary
+     */
+    void clear()
+    {
+        previous.reset( 0 );
+        current.reset( 0 );
+    }
+
+private:
+    struct Table {
+        static constexpr uint64_t empty_key = ~(uint64_t)0;
+
+        std::vector<uint64_t> keys;
+        std::vector<T> values;
+        size_t count = 0;
+
+        size_t slot( uint64_t key ) const
+        {
+            // haszowanie Fibonacciego
+            return (size_t)( ( key * 0x9E3779B97F4A7C15ull ) >> 32 ) & ( keys.size() - 1 );
+        }
+
+        void reset( size_t expected )
+        {
+            size_t capacity = 16;
+            while( capacity < 2 * expected )
+                capacity *= 2;
+
+            if( keys.size() < capacity )
+            {
+                keys.resize( capacity );
+                values.resize( capacity );
+            }
+
+            std::fill( keys.begin(), keys.end(), empty_key );
+            count = 0;
+        }
+
+        T *find( uint64_t key )
+        {
+            if( count == 0 ) return nullptr;
+
+            for( size_t i = slot( key ); ; i = ( i + 1 ) & ( keys.size() - 1 ) )
+            {
+                if( keys[i] == key ) return &values[i];
+                if( keys[i] == empty_key ) return nullptr;
+            }
+        }
+
+        T &insert( uint64_t key, const T &value )
+        {
+            if( 2 * ( count + 1 ) > keys.size() )
+                grow();
+
+            size_t i = slot( key );
+            while( keys[i] != empty_key )
+                i = ( i + 1 ) & ( keys.size() - 1 );
+
+            keys[i] = key;
+            values[i] = value;
+            count++;
+
+            return values[i];
+        }
+
+        void grow()
+        {
+            std::vector<uint64_t> old_keys( keys.size() * 2, empty_key );
+            std::vector<T> old_values( values.size() * 2 );
+
+            old_keys.swap( keys );
+            old_values.swap( values );
+            count = 0;
+
+            for( size_t i = 0; i < old_keys.size(); i++ )
+                if( old_keys[i] != empty_key )
+                    insert( old_keys[i], old_values[i] );
+        }
+    };
+
+    Table previous, current;
+};
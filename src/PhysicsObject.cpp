@@ -1,6 +1,6 @@
 /*
 Jakub Janeczko
-obiekt fizyki i odcinek
+obiekt fizyki
 3.06.2023
 */
 
@@ -11,15 +11,10 @@ obiekt fizyki i odcinek
 #include <vector>
 #include <stdexcept>
 #include <algorithm>
+#include <limits>
 
 constexpr double epsilon = 1e-13;
 
-// obrót o 90 stopni w lewo
-static glm::dvec2 rot90( const glm::dvec2 &a )
-{
-    return glm::dvec2{ -a.y, a.x };
-}
-
 const auto &cross = vec_cross;
 
 // > 0 jeśli (a->b)-(b->c) przechodzi odwrotnie do ruchu wskazówek zegara
@@ -96,21 +91,23 @@ PhysicsObject::PhysicsObject(std::vector<glm::dvec2> point_cloud, double density
     center = centroid;
     inv_mass = 1.0 / (area * density);
     
-    points = std::move(hull);
-
     // zapisz punkty względem środka
-    for( glm::dvec2 &point : points )
+    for( glm::dvec2 &point : hull )
         point -= center;
 
+    shape = Shape( std::move(hull) );
+
+    const std::vector<glm::dvec2> &local_points = shape.local_points;
+
     // oblicz moment bezwładności obiektu
     // całkowity moment jest sumą momentów wszystkich trójkątów
     // https://physics.stackexchange.com/questions/708936/how-to-calculate-the-moment-of-inertia-of-convex-polygon-two-dimensions
     double momentArea = 0.0;
     
-    for( size_t i = 0; i < points.size(); i++ )
+    for( size_t i = 0; i < local_points.size(); i++ )
     {
-        const glm::dvec2 &a = points[i],
-                         &b = points[i == points.size() - 1 ? 0 : i+1];
+        const glm::dvec2 &a = local_points[i],
+                         &b = local_points[i == local_points.size() - 1 ? 0 : i+1];
         
         momentArea += (glm::dot(a,a) + glm::dot(b,b) + glm::dot(a,b)) * cross( a, b );
     }
@@ -125,10 +122,24 @@ PhysicsObject::PhysicsObject(std::vector<glm::dvec2> point_cloud, double density
         inv_mass = 0.0;
         inv_moment_of_intertia = 0.0;
     }
+
+    velocity = glm::dvec2( 0.0 );
+    angle = 0.0;
+    ang_velocity = 0.0;
+    sleep_time = 0.0;
+}
+
+void PhysicsObject::wake_up()
+{
+    flags &= ~Sleeping;
+    sleep_time = 0.0;
 }
 
 void PhysicsObject::add_impulse( glm::dvec2 point_of_application, glm::dvec2 value )
 {
+    if( flags & Sleeping )
+        wake_up();
+
     velocity += value * inv_mass;
     ang_velocity += vec_cross( point_of_application, value ) * inv_moment_of_intertia;
 }
@@ -149,53 +160,34 @@ void PhysicsObject::move_by( glm::dvec2 vec, double d_angle )
 {
     center += vec;
     angle += d_angle;
-
-    // obróć punkty by odzwierciedlały prawdziwą pozycję
-    double c_a = cos( d_angle ),
-           s_a = sin( d_angle );
-
-    const glm::dmat2 rot_angle{
-         c_a, s_a,
-        -s_a, c_a
-    };
-
-    for( glm::dvec2 &point : points )
-        point = rot_angle * point;
 }
 
-Edge PhysicsObject::get_closest_edge( const glm::dvec2 &point ) const
+const std::vector<glm::dvec2> &PhysicsObject::get_points() const
 {
-    const glm::dvec2 pt = point - center;
-
-    for( size_t i = 0; i < points.size() - 1; i++ )
-    {
-        // punkt pomiędzy dwoma wierzchołkami
-        if( cross( points[i], pt ) >= 0 &&
-            cross( pt, points[i+1] ) >= 0 )
-            return { center + points[i], center + points[i+1] };
-    }
+    return shape.get_points( angle );
+}
 
-    assert(
-        cross( points.back(), pt ) >= 0 &&
-        cross( pt, points.front() ) >= 0
-    );
+const std::vector<glm::dvec2> &PhysicsObject::get_normals() const
+{
+    return shape.get_normals( angle );
+}
 
-    return { center + points.back(), center + points.front() };
+AABB PhysicsObject::get_aabb() const
+{
+    return shape.get_aabb( center, angle );
 }
 
-double Edge::signed_distance( const glm::dvec2 &p ) const
+Polygon PhysicsObject::get_polygon() const
 {
-    return glm::dot( p - a, get_normal() );
+    return shape.get_polygon( center, angle );
 }
 
-bool PhysicsObject::is_point_inside_object( const glm::dvec2 &p ) const
+Edge PhysicsObject::get_closest_edge( const glm::dvec2 &point ) const
 {
-    const Edge closest_edge = get_closest_edge( p );
-    const double dist = closest_edge.signed_distance( p );
-    return dist <= 0;
+    return get_polygon().get_closest_edge( point );
 }
 
-glm::dvec2 Edge::get_normal() const
+bool PhysicsObject::is_point_inside_object( const glm::dvec2 &p ) const
 {
-    return glm::normalize( -rot90( b - a ) );
-}
\ No newline at end of file
+    return get_polygon().is_point_inside( p );
+}
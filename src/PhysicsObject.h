@@ -1,49 +1,17 @@
 /*
 Jakub Janeczko
-nagłówek klasy obiektu fizyki i odcinka
+nagłówek klasy obiektu fizyki
 31.05.2023
 */
 
 #pragma once
 
+#include "Shape.h"
+
 #include <glm/glm.hpp>
 
 #include <vector>
 
-/**
- * \brief skierowany odcinek
- */
-class Edge
-{
-public:
-    glm::dvec2 a, b;
-
-    /**
-     * @brief oblicza odległość ze znakiem punktu od prostej a-b
-     * 
-     * zwraca dodatnią wartość po jej lewej stronie patrząc się z a do b
-     * równą zeru gdy punkt jest na prostej
-     * a ujemną w przeciwnym przypadku
-     * 
-     * mkduł zwrócowaj wartości jest równy odległości kartezjańskiej punktu od prostej
-     * 
-     * @param p punkt do rozpatrzenia odległości
-     * @return double odległość ze znakiem prostej od punktu
-     */
-    double signed_distance( const glm::dvec2 &p ) const;
-
-
-    /**
-     * @brief oblicza wektor normalny do odcinka
-     * 
-     * wektor normalny skierowany jest w 'lewo' patrząc się z a do b
-     * 
-     * @param p punkt do rozpatrzenia odległości
-     * @return glm::dvec2 wektor normalny do odcinka
-     */
-    glm::dvec2 get_normal() const;
-};
-
 /**
  * \brief symulowany obiekt
  * 
@@ -74,7 +42,14 @@ public:
      */
     PhysicsObject(std::vector<glm::dvec2> point_cloud, double density, uint32_t flags = 0 );
 
-    std::vector<glm::dvec2> points; ///< pozycje punktów względem środka [m]
+    /**
+     * @brief kształt obiektu
+     * 
+     * nie zmienia się w trakcie symulacji, obecne położenie punktów
+     * wyznacza środek i kąt obiektu (zobacz get_points)
+     */
+    Shape shape;
+
     double inv_mass; ///< odwrotność masy [1/kg]
     double inv_moment_of_intertia; ///< odwrotność momentu bezwładności [1/(kg*m2)]
     
@@ -87,14 +62,29 @@ public:
      * @brief dodatkowe opcje symulowanego obiektu
      */
     enum FlagBits {
-        Immovable = 1 << 0 ///< obiekt który nie powinien się poruszać
+        Immovable = 1 << 0, ///< obiekt który nie powinien się poruszać
+
+        /**
+         * @brief obiekt uśpiony - spoczywa i nie jest symulowany
+         *        aż do kontaktu z obudzonym obiektem lub impulsu
+         */
+        Sleeping = 1 << 1
     };
 
     uint32_t flags; ///< dodatkowe opcje, 0 lub więcej bitów FlagBits
 
+    double sleep_time; ///< jak długo obiekt prawie się nie porusza [s]
+
+    /**
+     * @brief budzi uśpiony obiekt
+     */
+    void wake_up();
+
     /**
      * @brief zaaplikuj impuls do obiektu
      * 
+     * budzi obiekt jeżeli jest uśpiony
+     * 
      * @param point_of_application punkt przyłożenia siły
      * @param value impuls przyłożony [N * s]
      */
@@ -117,6 +107,35 @@ public:
      */
     void move_by( glm::dvec2 vec, double angle );
 
+    /**
+     * @brief zwraca punkty obiektu obrócone o jego obecny kąt [m]
+     * 
+     * punkty są względem środka obiektu, pozycje w świecie to center + punkt
+     * 
+     * punkty są obliczane leniwie z kształtu i pamiętane aż do
+     * następnej zmiany kąta (przesunięcia ich nie unieważniają)
+     */
+    const std::vector<glm::dvec2> &get_points() const;
+
+    /**
+     * @brief zwraca zewnętrzne normalne krawędzi obrócone o obecny kąt obiektu
+     * 
+     * korzysta z tej samej pamięci podręcznej co get_points
+     */
+    const std::vector<glm::dvec2> &get_normals() const;
+
+    /**
+     * @brief zwraca AABB obiektu w obecnej pozycji
+     * 
+     * korzysta z tej samej pamięci podręcznej co get_points
+     */
+    AABB get_aabb() const;
+
+    /**
+     * @brief zwraca wielokąt obiektu w obecnej pozycji
+     */
+    Polygon get_polygon() const;
+
 
     /**
      * get the closest edge to the point
@@ -142,10 +161,3 @@ public:
     bool is_point_inside_object( const glm::dvec2 &p ) const;
 };
 
-/**
- * @brief oblicza trzecią współrzędną cross-produktu pomiędzy wektorami
- */
-inline double vec_cross( const glm::dvec2 &a, const glm::dvec2 &b )
-{
-    return a.x*b.y - a.y*b.x;
-}
\ No newline at end of file
@@ -0,0 +1,105 @@
+/*
+Jakub Janeczko
+wątek symulacji
+18.10.2026
+*/
+
+#include "PhysicsThread.h"
+#include "Profiler.h"
+
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <thread>
+#include <math.h>
+
+PhysicsThread::PhysicsThread( IPhysicsEngine *engine, World world,
+    double step_dt, int max_steps )
+    : engine(engine)
+    , world(std::move(world))
+    , step_dt(step_dt)
+    , max_steps(max_steps)
+{
+    previous_poses.assign( this->world );
+    publish( 0.0, std::chrono::steady_clock::now() );
+    thread = std::thread( &PhysicsThread::run, this );
+}
+
+PhysicsThread::~PhysicsThread()
+{
+    stopping.store( true, std::memory_order_relaxed );
+    thread.join();
+}
+
+void PhysicsThread::run()
+{
+    using namespace std::chrono;
+
+    Profiler::set_thread_name( "physics" );
+
+    auto last_timestamp = steady_clock::now();
+    double accumulator = 0.0; ///< czas do nadrobienia przez symulację [s]
+    double tick_time = 0.0;
+
+    while( !stopping.load( std::memory_order_relaxed ) )
+    {
+        const auto cur_timestamp = steady_clock::now();
+        accumulator += duration<double>( cur_timestamp - last_timestamp ).count();
+        last_timestamp = cur_timestamp;
+
+        int steps = 0;
+        while( accumulator >= step_dt && steps < max_steps )
+        {
+            // zmiany przed zapamiętaniem położeń, by indeksy obu stanów się zgadzały
+            {
+                PROFILE_ZONE( "execute_commands" );
+                commands.execute( world );
+                previous_poses.assign( world );
+            }
+
+            const auto step_start = steady_clock::now();
+            engine->onTick( world, step_dt );
+            tick_time = duration<double>( steady_clock::now() - step_start ).count();
+
+            tick++;
+            steps++;
+            accumulator -= step_dt;
+        }
+
+        // kroki nie nadążają - pomiń zaległy czas zamiast go nadrabiać
+        if( accumulator >= step_dt )
+            accumulator = fmod( accumulator, step_dt );
+
+        // obecny stan odpowiada chwili sprzed accumulator sekund
+        const auto accumulated = duration_cast<steady_clock::duration>(
+            duration<double>( accumulator ) );
+
+        if( steps > 0 )
+            publish( tick_time, cur_timestamp - accumulated );
+
+        std::this_thread::sleep_until( cur_timestamp - accumulated +
+            duration_cast<steady_clock::duration>( duration<double>( step_dt ) ) );
+    }
+}
+
+void PhysicsThread::publish( double tick_time,
+    std::chrono::steady_clock::time_point state_time )
+{
+    PROFILE_ZONE( "publish_snapshot" );
+
+    if( !shapes || shapes_revision != world.get_revision() )
+    {
+        shapes = std::make_shared<const std::vector<Shape>>( world.shapes );
+        shapes_revision = world.get_revision();
+    }
+
+    WorldSnapshot &snapshot = snapshots.back();
+    snapshot.assign( world, previous_poses, shapes );
+    snapshot.tick = tick;
+    snapshot.tick_time = tick_time;
+    snapshot.step_dt = step_dt;
+    snapshot.state_time = state_time;
+    snapshot.status = engine->get_status();
+
+    snapshots.publish();
+}
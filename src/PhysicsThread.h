@@ -0,0 +1,92 @@
+/*
+Jakub Janeczko
+nagłówek wątku symulacji
+18.10.2026
+*/
+
+#pragma once
+
+#include "interfaces.h"
+#include "World.h"
+#include "WorldSnapshot.h"
+#include "WorldCommandQueue.h"
+#include "TripleBuffer.h"
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <stdint.h>
+
+/**
+ * @brief wykonuje kroki symulacji w osobnym wątku
+ * 
+ * symulacja wykonuje kroki o stałym czasie step_dt - upływający czas jest
+ * zbierany w akumulatorze i wykonywane jest tyle kroków ile się w nim mieści,
+ * ale nie więcej niż max_steps naraz. Gdy kroki nie nadążają za zegarem
+ * nadmiar czasu jest pomijany (symulacja zwalnia zamiast się zatrzymać),
+ * więc koszt jednej iteracji jest ograniczony
+ * 
+ * świat należy wyłącznie do wątku symulacji. Po każdym kroku jego stan jest
+ * kopiowany do migawki publikowanej przez potrójny bufor, więc wątek
+ * rysujący czyta najnowszy stan bez blokad i bez czekania na krok symulacji.
+ * Zmiany świata (dodawanie, usuwanie obiektów, impulsy) są zlecane przez
+ * kolejkę i wykonywane przez wątek symulacji przed kolejnym krokiem
+ * 
+ * parametry silnika mogą być zmieniane jedynie przez kolejkę zmian
+ */
+class PhysicsThread {
+public:
+    /**
+     * @brief publikuje migawkę początkowego stanu i uruchamia wątek symulacji
+     * 
+     * @param engine silnik fizyki, musi istnieć dłużej niż PhysicsThread
+     * @param world początkowy stan świata
+     * @param step_dt stały krok czasu symulacji [s]
+     * @param max_steps największa liczba kroków wykonywanych naraz
+     */
+    PhysicsThread( IPhysicsEngine *engine, World world,
+        double step_dt = 1.0 / 120.0, int max_steps = 8 );
+
+    /**
+     * @brief zatrzymuje wątek symulacji i czeka na jego zakończenie
+     */
+    ~PhysicsThread();
+
+    PhysicsThread( const PhysicsThread& ) = delete;
+    PhysicsThread &operator=( const PhysicsThread& ) = delete;
+
+    /**
+     * @brief zwraca najnowszą migawkę świata
+     * 
+     * może być wywoływane tylko przez jeden wątek (rysujący), migawka
+     * jest ważna do następnego wywołania
+     */
+    const WorldSnapshot &get_snapshot() { return snapshots.acquire(); }
+
+    /**
+     * @brief zwraca kolejkę zmian świata
+     */
+    WorldCommandQueue &get_commands() { return commands; }
+
+private:
+    IPhysicsEngine *engine;
+    World world; ///< stan symulacji, używany tylko przez wątek symulacji
+    double step_dt;
+    int max_steps;
+
+    WorldCommandQueue commands;
+    TripleBuffer<WorldSnapshot> snapshots;
+
+    std::shared_ptr<const std::vector<Shape>> shapes; ///< kopia world.shapes dla migawek
+    uint64_t shapes_revision = 0; ///< World::get_revision z chwili kopiowania shapes
+    BodyPoses previous_poses; ///< położenia obiektów przed ostatnim krokiem
+    uint64_t tick = 0; ///< liczba wykonanych kroków
+
+    std::atomic<bool> stopping{ false };
+    std::thread thread;
+
+    void run();
+    void publish( double tick_time, std::chrono::steady_clock::time_point state_time );
+};
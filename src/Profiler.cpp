@@ -0,0 +1,244 @@
+/*
+Jakub Janeczko
+profiler stref czasowych
+18.10.2026
+*/
+
+#include "Profiler.h"
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <stdio.h>
+
+namespace {
+
+/**
+ * @brief miejsce na jedną strefę w buforze cyklicznym
+ *
+ * pola są atomowe, bo wątek czytający może czytać miejsce
+ * nadpisywane właśnie przez wątek zapisujący (odrzuca wtedy wynik)
+ */
+struct ProfileSlot {
+    std::atomic<const char*> name{ nullptr };
+    std::atomic<uint64_t> start_ns{ 0 };
+    std::atomic<uint64_t> end_ns{ 0 };
+    std::atomic<uint32_t> depth{ 0 };
+};
+
+/**
+ * @brief bufor cykliczny stref jednego wątku, zapisywany tylko przez ten wątek
+ */
+struct ThreadBuffer {
+    static constexpr size_t capacity = 1 << 14;
+
+    ProfileSlot slots[capacity];
+    std::atomic<uint64_t> written{ 0 }; ///< liczba zapisanych stref od początku
+    std::atomic<const char*> name{ nullptr }; ///< nazwa wątku
+    uint32_t thread = 0; ///< numer wątku
+    bool in_use = false; ///< czy wątek bufora działa, chronione przez buffers_mutex
+};
+
+std::mutex buffers_mutex;
+std::vector<std::unique_ptr<ThreadBuffer>> buffers; ///< bufory wszystkich wątków, chronione przez buffers_mutex
+
+/**
+ * @brief bufor obecnego wątku, zwalniany do ponownego użycia gdy wątek się kończy
+ */
+struct ThreadBufferHandle {
+    ThreadBuffer *buffer = nullptr;
+
+    ~ThreadBufferHandle()
+    {
+        if( !buffer ) return;
+
+        std::lock_guard<std::mutex> lock( buffers_mutex );
+        buffer->in_use = false;
+    }
+};
+
+thread_local ThreadBufferHandle current_buffer;
+thread_local const char *current_thread_name = nullptr;
+thread_local uint32_t current_depth = 0;
+
+const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+ThreadBuffer &get_thread_buffer()
+{
+    if( !current_buffer.buffer )
+    {
+        std::lock_guard<std::mutex> lock( buffers_mutex );
+
+        // bufor zakończonego wątku zamiast nowego, by wątki uruchamiane
+        // ponownie nie zwiększały zużycia pamięci
+        const auto unused = std::find_if( buffers.begin(), buffers.end(),
+            []( const std::unique_ptr<ThreadBuffer> &b ) { return !b->in_use; } );
+
+        ThreadBuffer *buffer;
+        if( unused != buffers.end() )
+        {
+            // strefy poprzedniego wątku są usuwane, numer wątku zostaje
+            buffer = unused->get();
+            buffer->written.store( 0, std::memory_order_relaxed );
+        }
+        else
+        {
+            buffers.push_back( std::make_unique<ThreadBuffer>() );
+            buffer = buffers.back().get();
+            buffer->thread = (uint32_t)( buffers.size() - 1 );
+        }
+
+        buffer->in_use = true;
+        buffer->name.store( current_thread_name, std::memory_order_relaxed );
+        current_buffer.buffer = buffer;
+    }
+
+    return *current_buffer.buffer;
+}
+
+// dopisuje do out strefy z bufora, pomija nadpisane w trakcie odczytu
+void collect_buffer( const ThreadBuffer &buffer, std::vector<ProfileRecord> &out,
+    uint64_t since_ns )
+{
+    const uint64_t written = buffer.written.load( std::memory_order_acquire );
+    const uint64_t first = written > ThreadBuffer::capacity ?
+        written - ThreadBuffer::capacity : 0;
+
+    const size_t out_begin = out.size();
+
+    for( uint64_t i = first; i < written; i++ )
+    {
+        const ProfileSlot &slot = buffer.slots[i % ThreadBuffer::capacity];
+
+        // odczyty acquire łączą się z barierą w end_zone, a ponowny odczyt
+        // written nie wyprzedza odczytu pól
+        ProfileRecord record;
+        record.name = slot.name.load( std::memory_order_acquire );
+        record.start_ns = slot.start_ns.load( std::memory_order_acquire );
+        record.end_ns = slot.end_ns.load( std::memory_order_acquire );
+        record.depth = slot.depth.load( std::memory_order_acquire );
+        record.thread = buffer.thread;
+
+        out.push_back( record );
+    }
+
+    // strefy które wątek mógł zacząć nadpisywać w trakcie odczytu są odrzucane
+    const uint64_t written_after = buffer.written.load( std::memory_order_relaxed );
+    const uint64_t valid_first = written_after + 1 > ThreadBuffer::capacity ?
+        written_after + 1 - ThreadBuffer::capacity : 0;
+
+    const size_t skip = (size_t)( std::max( valid_first, first ) - first );
+    out.erase( out.begin() + out_begin,
+        out.begin() + out_begin + std::min( skip, out.size() - out_begin ) );
+
+    out.erase( std::remove_if( out.begin() + out_begin, out.end(),
+        [&]( const ProfileRecord &r ) { return r.end_ns < since_ns; } ), out.end() );
+}
+
+} // namespace
+
+void Profiler::set_enabled( bool enable )
+{
+    enabled.store( enable, std::memory_order_relaxed );
+}
+
+void Profiler::set_thread_name( const char *name )
+{
+    current_thread_name = name;
+
+    if( current_buffer.buffer )
+        current_buffer.buffer->name.store( name, std::memory_order_relaxed );
+}
+
+uint64_t Profiler::now()
+{
+    using namespace std::chrono;
+    return (uint64_t)duration_cast<nanoseconds>( steady_clock::now() - start_time ).count();
+}
+
+uint32_t Profiler::begin_zone()
+{
+    return current_depth++;
+}
+
+void Profiler::end_zone( const char *name, uint64_t start_ns, uint32_t depth )
+{
+    const uint64_t end_ns = now();
+    current_depth--;
+
+    ThreadBuffer &buffer = get_thread_buffer();
+
+    const uint64_t i = buffer.written.load( std::memory_order_relaxed );
+    ProfileSlot &slot = buffer.slots[i % ThreadBuffer::capacity];
+
+    // wątek czytający, który zobaczy którekolwiek z nowych pól, zobaczy też
+    // written == i, więc odrzuci nadpisywaną strefę (zobacz collect_buffer)
+    // - bez bariery procesory o słabym porządku pamięci mogą zapisać pola
+    // przed poprzednim zapisem written
+    std::atomic_thread_fence( std::memory_order_release );
+
+    slot.name.store( name, std::memory_order_relaxed );
+    slot.start_ns.store( start_ns, std::memory_order_relaxed );
+    slot.end_ns.store( end_ns, std::memory_order_relaxed );
+    slot.depth.store( depth, std::memory_order_relaxed );
+
+    buffer.written.store( i + 1, std::memory_order_release );
+}
+
+void Profiler::collect( std::vector<ProfileRecord> &out, uint64_t since_ns )
+{
+    std::lock_guard<std::mutex> lock( buffers_mutex );
+
+    for( const std::unique_ptr<ThreadBuffer> &buffer : buffers )
+        collect_buffer( *buffer, out, since_ns );
+}
+
+bool Profiler::write_chrome_trace( const char *path )
+{
+    std::vector<ProfileRecord> records;
+    std::vector<std::pair<uint32_t, const char*>> thread_names;
+
+    {
+        std::lock_guard<std::mutex> lock( buffers_mutex );
+
+        for( const std::unique_ptr<ThreadBuffer> &buffer : buffers )
+        {
+            collect_buffer( *buffer, records, 0 );
+            thread_names.emplace_back( buffer->thread,
+                buffer->name.load( std::memory_order_relaxed ) );
+        }
+    }
+
+    FILE *out = fopen( path, "w" );
+    if( !out )
+        return false;
+
+    fprintf( out, "{\"traceEvents\":[\n" );
+
+    bool first = true;
+
+    for( const auto &[thread, name] : thread_names )
+    {
+        if( !name ) continue;
+
+        fprintf( out, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+            "\"args\":{\"name\":\"%s\"}}", first ? "" : ",\n", thread, name );
+        first = false;
+    }
+
+    // czasy w mikrosekundach
+    for( const ProfileRecord &r : records )
+    {
+        fprintf( out, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+            "\"ts\":%.3f,\"dur\":%.3f}", first ? "" : ",\n",
+            r.name, r.thread, r.start_ns / 1000.0, ( r.end_ns - r.start_ns ) / 1000.0 );
+        first = false;
+    }
+
+    fprintf( out, "\n]}\n" );
+
+    return fclose( out ) == 0;
+}
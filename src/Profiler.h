@@ -0,0 +1,125 @@
+/*
+Jakub Janeczko
+nagłówek profilera stref czasowych
+18.10.2026
+*/
+
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief zmierzony przedział czasu strefy
+ */
+struct ProfileRecord {
+    const char *name; ///< nazwa strefy (stały napis)
+    uint64_t start_ns; ///< początek względem uruchomienia programu [ns]
+    uint64_t end_ns; ///< koniec względem uruchomienia programu [ns]
+    uint32_t thread; ///< numer wątku (kolejność pierwszego pomiaru)
+    uint32_t depth; ///< zagnieżdżenie strefy w wątku, 0 dla zewnętrznej
+};
+
+/**
+ * @brief profiler stref - nazwanych przedziałów kodu mierzonych przez ProfileZone
+ *
+ * każdy wątek zapisuje zakończone strefy do własnego bufora cyklicznego
+ * bez blokad, najstarsze strefy są nadpisywane. Inne wątki mogą w każdej
+ * chwili odczytać zapisane strefy (collect) lub zapisać je jako ślad
+ * w formacie Chrome (chrome://tracing, Perfetto)
+ *
+ * gdy profiler jest wyłączony strefa kosztuje jedno sprawdzenie flagi
+ *
+ * bufor zakończonego wątku jest używany ponownie przez następny nowy wątek
+ * (np. po ponownym uruchomieniu JobSystem), wtedy jego strefy są usuwane
+ */
+class Profiler {
+public:
+    /**
+     * @brief włącza lub wyłącza zapisywanie stref
+     */
+    static void set_enabled( bool enabled );
+
+    static bool is_enabled() { return enabled.load( std::memory_order_relaxed ); }
+
+    /**
+     * @brief nadaje nazwę obecnemu wątkowi w śladzie (stały napis)
+     */
+    static void set_thread_name( const char *name );
+
+    /**
+     * @brief zwraca czas od uruchomienia programu [ns]
+     */
+    static uint64_t now();
+
+    /**
+     * @brief dopisuje do out zapisane strefy zakończone nie wcześniej niż since_ns
+     *
+     * strefy jednego wątku są w kolejności ich zakończenia
+     */
+    static void collect( std::vector<ProfileRecord> &out, uint64_t since_ns = 0 );
+
+    /**
+     * @brief zapisuje wszystkie zapisane strefy w formacie Chrome trace event (JSON)
+     *
+     * @return false jeżeli nie udało się zapisać pliku
+     */
+    static bool write_chrome_trace( const char *path );
+
+private:
+    friend class ProfileZone;
+
+    static inline std::atomic<bool> enabled{ false };
+
+    // zwiększa zagnieżdżenie stref obecnego wątku, zwraca poprzednie
+    static uint32_t begin_zone();
+
+    // zmniejsza zagnieżdżenie i zapisuje strefę do bufora obecnego wątku
+    static void end_zone( const char *name, uint64_t start_ns, uint32_t depth );
+};
+
+/**
+ * @brief mierzy czas od utworzenia do zniszczenia i zapisuje go jako strefę
+ *
+ * gdy profiler jest wyłączony w chwili utworzenia strefa nie jest zapisywana
+ *
+ * flaga jest odczytywana tylko w konstruktorze, a destruktor sprawdza name,
+ * które nie opuszcza strefy (begin_zone i end_zone nie dostają this) - kompilator
+ * zna jego wartość i łączy oba sprawdzenia, gdy powiela kod strefy
+ */
+class ProfileZone {
+public:
+    explicit ProfileZone( const char *zone_name )
+        : name( Profiler::is_enabled() ? zone_name : nullptr )
+    {
+        if( name )
+        {
+            depth = Profiler::begin_zone();
+            start_ns = Profiler::now();
+        }
+    }
+
+    ~ProfileZone()
+    {
+        if( name )
+            Profiler::end_zone( name, start_ns, depth );
+    }
+
+    ProfileZone( const ProfileZone& ) = delete;
+    ProfileZone &operator=( const ProfileZone& ) = delete;
+
+private:
+    const char *name; ///< nazwa strefy lub nullptr gdy nie jest mierzona
+    uint64_t start_ns = 0;
+    uint32_t depth = 0;
+};
+
+#define PROFILE_CONCAT_IMPL( a, b ) a##b
+#define PROFILE_CONCAT( a, b ) PROFILE_CONCAT_IMPL( a, b )
+
+/**
+ * @brief mierzy czas do końca obecnego bloku jako strefę o nazwie name
+ */
+#define PROFILE_ZONE( name ) ProfileZone PROFILE_CONCAT( profile_zone_, __LINE__ )( name )
@@ -0,0 +1,99 @@
+/*
+Jakub Janeczko
+szeroka faza metodą sortowania i zamiatania
+18.10.2026
+*/
+
+#include "SAP_Broadphase.h"
+#include "AABBArray.h"
+
+#include <vector>
+#include <algorithm>
+
+// liczba obiektów zamiatanych w jednym zadaniu
+constexpr size_t sweep_grain = 256;
+
+void SAP_Broadphase::find_pairs( const std::vector<AABB> &aabbs,
+    std::vector<BodyPair> &pairs )
+{
+    pairs.clear();
+
+    const uint32_t n = (uint32_t)aabbs.size();
+
+    const auto by_min_x = [&aabbs]( uint32_t a, uint32_t b )
+    {
+        return aabbs[a].min.x < aabbs[b].min.x;
+    };
+
+    if( order.size() != n )
+    {
+        // liczba obiektów się zmieniła - usuń nieistniejące indeksy i dodaj nowe
+        order.erase( std::remove_if( order.begin(), order.end(),
+            [n]( uint32_t idx ) { return idx >= n; } ), order.end() );
+
+        for( uint32_t i = (uint32_t)order.size(); i < n; i++ )
+            order.push_back( i );
+
+        // nowe obiekty mogą być w dowolnym miejscu - posortuj od nowa
+        std::sort( order.begin(), order.end(), by_min_x );
+    }
+    else
+    {
+        // sortowanie przez wstawianie - lista jest prawie posortowana z poprzedniego kroku
+        for( size_t i = 1; i < order.size(); i++ )
+        {
+            const uint32_t idx = order[i];
+            size_t j = i;
+
+            while( j > 0 && by_min_x( idx, order[j-1] ) )
+            {
+                order[j] = order[j-1];
+                j--;
+            }
+
+            order[j] = idx;
+        }
+    }
+
+    // zamiataj - dla każdego obiektu rozpatrz tylko te, które zaczynają się
+    // przed jego końcem na osi x, sprawdzając je wsadami po aabb_batch
+    sorted.assign( aabbs, order );
+
+    // każdy fragment zapisuje pary do własnej tablicy, łączonych w kolejności
+    chunk_pairs.reset( JobSystem::chunk_count( n, sweep_grain ) );
+    thread_tests.reset( get_thread_count() );
+
+    parallel_for( jobs, n, sweep_grain, [&]( const JobRange &range )
+    {
+        std::vector<BodyPair> &out = chunk_pairs[range.chunk];
+        uint64_t tests = 0;
+
+        for( size_t i = range.begin; i < range.end; i++ )
+        {
+            const uint32_t idx_a = order[i];
+            const AABB &a = aabbs[idx_a];
+
+            for( size_t first = i + 1; first < n; first += AABBArray::aabb_batch )
+            {
+                uint32_t mask = overlap_mask( a, sorted, first );
+                tests += std::min<size_t>( AABBArray::aabb_batch, n - first );
+
+                while( mask )
+                {
+                    const uint32_t idx_b = order[first + lowest_bit( mask )];
+                    out.emplace_back( std::min( idx_a, idx_b ), std::max( idx_a, idx_b ) );
+                    mask &= mask - 1;
+                }
+
+                // min.x jest posortowane - jeżeli ostatni prostokąt wsadu zaczyna się
+                // za końcem a to kolejne też (dopełnienie ma min.x = +inf)
+                if( sorted.min_x[first + AABBArray::aabb_batch - 1] > a.max.x ) break;
+            }
+        }
+
+        thread_tests[range.thread] += tests;
+    } );
+
+    chunk_pairs.append_to( pairs );
+    aabb_tests = thread_tests.merged();
+}
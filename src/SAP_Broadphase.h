@@ -0,0 +1,36 @@
+/*
+Jakub Janeczko
+nagłówek szerokiej fazy metodą sortowania i zamiatania
+18.10.2026
+*/
+
+#pragma once
+
+#include "Broadphase.h"
+#include "AABBArray.h"
+
+#include <vector>
+#include <stdint.h>
+
+/**
+ * @brief szeroka faza metodą sortowania i zamiatania (sweep and prune)
+ * 
+ * przechowuje obiekty posortowane po początku AABB na osi x pomiędzy
+ * kolejnymi krokami - ponieważ obiekty poruszają się niewiele kolejność
+ * prawie się nie zmienia i sortowanie przez wstawianie działa w czasie
+ * prawie liniowym
+ * 
+ * następnie zamiata posortowaną listę szukając przecięć przedziałów na osi x
+ * i sprawdzając przecięcie na osi y - kolejne obiekty są sprawdzane wsadami
+ * przez overlap_mask
+ */
+class SAP_Broadphase : public IBroadphase {
+public:
+    virtual void find_pairs( const std::vector<AABB> &aabbs,
+        std::vector<BodyPair> &pairs );
+
+private:
+    std::vector<uint32_t> order; ///< indeksy obiektów posortowane po aabb.min.x
+    AABBArray sorted; ///< AABB obiektów w kolejności order
+    ChunkOutput<BodyPair> chunk_pairs; ///< pary znalezione w kolejnych fragmentach zamiatania
+};
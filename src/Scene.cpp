@@ -0,0 +1,104 @@
+/*
+Jakub Janeczko
+sceny początkowe symulacji
+18.10.2026
+*/
+
+#include "Scene.h"
+#include "PhysicsObject.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+World create_arena_scene()
+{
+    const double
+        arena_width = 1000,
+        arena_height = 1000,
+        wall_thickness = 1000;
+    
+    const double a_hw = arena_width / 2.0, // arena half width
+                 a_h = arena_height,
+                 w_t = wall_thickness; 
+
+    const PhysicsObject scene[]{
+        PhysicsObject(
+            {
+                {-a_hw, 0},
+                { a_hw, 0},
+                { a_hw, -w_t},
+                {-a_hw, -w_t}
+            }, 1.0, PhysicsObject::FlagBits::Immovable ),
+        PhysicsObject(
+            {
+                {-a_hw,       -w_t},
+                {-a_hw - w_t, -w_t},
+                {-a_hw,        a_h},
+                {-a_hw - w_t,  a_h}
+            }, 1.0, PhysicsObject::FlagBits::Immovable ),
+        PhysicsObject(
+            {
+                { a_hw,       -w_t},
+                { a_hw + w_t, -w_t},
+                { a_hw,        a_h},
+                { a_hw + w_t,  a_h}
+            }, 1.0, PhysicsObject::FlagBits::Immovable ),
+        PhysicsObject(
+            {
+                { a_hw + w_t,  a_h},
+                {-a_hw - w_t,  a_h},
+                { a_hw + w_t,  a_h + w_t},
+                {-a_hw - w_t,  a_h + w_t}
+            }, 1.0, PhysicsObject::FlagBits::Immovable ),
+        PhysicsObject(
+            {
+                {-10, 5},
+                { 10, 5},
+                { 0, 15}
+            }, 1.0, 0 ),
+    };
+
+    World world;
+    for( const PhysicsObject &obj : scene )
+        world.add( obj );
+
+    return world;
+}
+
+void add_random_polygons( World &world, size_t count, uint32_t seed, double max_radius )
+{
+    std::mt19937 rng( seed );
+    std::uniform_int_distribution<int> vertex_count( 3, 8 );
+    std::uniform_real_distribution<double> radius( max_radius / 3.0, max_radius );
+    std::uniform_real_distribution<double> jitter( -0.3, 0.3 );
+
+    // wielokąt jest wpisany w okrąg o promieniu max_radius, więc sąsiednie
+    // się nie przecinają (arena ma 1000 m szerokości)
+    const double cell = max_radius * 8.0 / 3.0;
+    const size_t columns = std::max<size_t>( 1, (size_t)( 800.0 / cell ) );
+
+    for( size_t i = 0; i < count; i++ )
+    {
+        const glm::dvec2 center(
+            ( (double)( i % columns ) - columns / 2.0 + 0.5 ) * cell,
+            ( (double)( i / columns ) + 1.0 ) * cell );
+
+        const int n = vertex_count( rng );
+        const double r = radius( rng );
+
+        std::vector<glm::dvec2> points;
+        for( int k = 0; k < n; k++ )
+        {
+            const double angle = ( k + jitter( rng ) ) * 2.0 * M_PI / n;
+            points.push_back( center + r * glm::dvec2( cos( angle ), sin( angle ) ) );
+        }
+
+        world.add( PhysicsObject( points, 1.0 ) );
+    }
+}
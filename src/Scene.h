@@ -0,0 +1,34 @@
+/*
+Jakub Janeczko
+nagłówek scen początkowych symulacji
+18.10.2026
+*/
+
+#pragma once
+
+#include "World.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief tworzy arenę - podłogę i ściany z nieruszalnych obiektów
+ *        oraz jeden trójkąt nad podłogą
+ * 
+ * podłoga ma górną krawędź na y = 0, arena ma 1000 m szerokości i wysokości
+ */
+World create_arena_scene();
+
+/**
+ * @brief dodaje losowe wielokąty wypukłe rozłożone w siatce nad podłogą areny
+ * 
+ * obiekty są układane w rzędach szerokości 800 m, w komórkach o boku
+ * 8/3 max_radius. Wynik zależy tylko od argumentów, przy domyślnym
+ * promieniu do 12000 obiektów mieści się pod sufitem areny (create_arena_scene)
+ * 
+ * @param count liczba dodawanych obiektów
+ * @param seed ziarno generatora liczb losowych
+ * @param max_radius największy promień obiektu, najmniejszy to 1/3 z niego [m]
+ */
+void add_random_polygons( World &world, size_t count, uint32_t seed,
+    double max_radius = 3.0 );
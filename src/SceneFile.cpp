@@ -0,0 +1,407 @@
+/*
+Jakub Janeczko
+binarny zapis sceny
+18.10.2026
+*/
+
+#include "SceneFile.h"
+#include "Shape.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <unordered_map>
+#include <type_traits>
+#include <cmath>
+#include <string.h>
+#include <stdio.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// punkty i normalne są kopiowane z pliku jako pary liczb
+static_assert( sizeof(glm::dvec2) == 2 * sizeof(double), "glm::dvec2 musi być ciągły" );
+
+namespace {
+
+/**
+ * @brief plik zmapowany do pamięci tylko do odczytu
+ */
+class MappedFile {
+public:
+    explicit MappedFile( const char *path );
+    ~MappedFile();
+
+    MappedFile( const MappedFile& ) = delete;
+    MappedFile &operator=( const MappedFile& ) = delete;
+
+    const uint8_t *data() const { return bytes; }
+    size_t size() const { return length; }
+
+private:
+    const uint8_t *bytes = nullptr; ///< nullptr gdy nie udało się zmapować pliku
+    size_t length = 0;
+
+#if defined(_WIN32)
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+};
+
+#if defined(_WIN32)
+
+MappedFile::MappedFile( const char *path )
+{
+    file = CreateFileA( path, GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+    if( file == INVALID_HANDLE_VALUE )
+        return;
+
+    LARGE_INTEGER file_size;
+    if( !GetFileSizeEx( file, &file_size ) || file_size.QuadPart == 0 )
+        return;
+
+    mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+    if( !mapping )
+        return;
+
+    bytes = (const uint8_t*)MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+    length = bytes ? (size_t)file_size.QuadPart : 0;
+}
+
+MappedFile::~MappedFile()
+{
+    if( bytes ) UnmapViewOfFile( bytes );
+    if( mapping ) CloseHandle( mapping );
+    if( file != INVALID_HANDLE_VALUE ) CloseHandle( file );
+}
+
+#else
+
+MappedFile::MappedFile( const char *path )
+{
+    const int fd = open( path, O_RDONLY );
+    if( fd < 0 )
+        return;
+
+    struct stat st;
+    if( fstat( fd, &st ) == 0 && st.st_size > 0 )
+    {
+        void *mapped = mmap( nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+        if( mapped != MAP_FAILED )
+        {
+            bytes = (const uint8_t*)mapped;
+            length = (size_t)st.st_size;
+
+            // cały plik zostanie przeczytany, system może go wczytać z wyprzedzeniem
+            madvise( mapped, length, MADV_WILLNEED );
+        }
+    }
+
+    // mapowanie pozostaje ważne po zamknięciu pliku
+    close( fd );
+}
+
+MappedFile::~MappedFile()
+{
+    if( bytes )
+        munmap( (void*)bytes, length );
+}
+
+#endif
+
+uint64_t align_up( uint64_t offset )
+{
+    return ( offset + scene_file_alignment - 1 ) / scene_file_alignment * scene_file_alignment;
+}
+
+// rozmiary sekcji [B] dla liczb obiektów, kształtów i punktów
+void get_section_sizes( const SceneFileHeader &header, uint64_t sizes[SceneSectionCount] )
+{
+    for( int s = SceneX; s <= SceneSleepTime; s++ )
+        sizes[s] = header.body_count * sizeof(double);
+
+    sizes[SceneFlags] = header.body_count * sizeof(uint32_t);
+    sizes[SceneBodyShape] = header.body_count * sizeof(uint32_t);
+    sizes[SceneShapes] = header.shape_count * sizeof(SceneFileShape);
+    sizes[ScenePoints] = header.vertex_count * sizeof(glm::dvec2);
+    sizes[SceneNormals] = header.vertex_count * sizeof(glm::dvec2);
+}
+
+// FNV-1a z bajtów punktów kształtu
+uint64_t hash_points( const std::vector<glm::dvec2> &points )
+{
+    const uint8_t *bytes = (const uint8_t*)points.data();
+    const size_t size = points.size() * sizeof(glm::dvec2);
+
+    uint64_t hash = 14695981039346656037ull;
+    for( size_t i = 0; i < size; i++ )
+        hash = ( hash ^ bytes[i] ) * 1099511628211ull;
+
+    return hash;
+}
+
+// zapisuje sekcję i wyrównuje plik do początku następnej
+bool write_section( FILE *out, const void *data, uint64_t size, uint64_t &offset )
+{
+    static const uint8_t padding[scene_file_alignment] = {};
+
+    if( size && fwrite( data, 1, (size_t)size, out ) != size )
+        return false;
+
+    const uint64_t end = offset + size;
+    offset = align_up( end );
+
+    return offset == end || fwrite( padding, 1, (size_t)( offset - end ), out ) == offset - end;
+}
+
+// sprawdza czy count elementów zmieści się w 32-bitowym indeksie
+bool fits_index( uint64_t count )
+{
+    return count <= UINT32_MAX;
+}
+
+bool is_finite( const glm::dvec2 &v )
+{
+    return std::isfinite( v.x ) && std::isfinite( v.y );
+}
+
+// sprawdza czy wielokąt jest ściśle wypukły, ma wierzchołki przeciwnie do
+// ruchu wskazówek zegara, a normalne są jednostkowe i skierowane na zewnątrz
+// krawędzi (jak w Shape), bo wąska faza zakłada to bez sprawdzania
+bool is_valid_shape( const glm::dvec2 *points, const glm::dvec2 *normals, size_t count )
+{
+    // dopuszczalny błąd zaokrągleń długości i kierunku normalnej
+    const double tolerance = 1e-9;
+
+    for( size_t i = 0; i < count; i++ )
+    {
+        const glm::dvec2 &a = points[i];
+        const glm::dvec2 &b = points[( i + 1 ) % count];
+        const glm::dvec2 &c = points[( i + 2 ) % count];
+        const glm::dvec2 &n = normals[i];
+
+        if( !is_finite( a ) || !is_finite( n ) )
+            return false;
+
+        const glm::dvec2 edge = b - a;
+        const double edge_length = glm::length( edge );
+
+        // wypukłość i kierunek obiegu - każdy kolejny zakręt w lewo
+        if( !( vec_cross( edge, c - b ) > 0.0 ) )
+            return false;
+
+        // normalna prostopadła do krawędzi, po jej prawej stronie
+        if( std::abs( glm::dot( n, n ) - 1.0 ) > tolerance ||
+            std::abs( glm::dot( n, edge ) ) > tolerance * edge_length ||
+            !( vec_cross( edge, n ) < 0.0 ) )
+            return false;
+    }
+
+    return true;
+}
+
+} // namespace
+
+bool save_scene( const char *path, const World &world )
+{
+    const size_t body_count = world.size();
+
+    // wspólna pula punktów, takie same kształty są zapisywane raz
+    std::vector<SceneFileShape> shapes;
+    std::vector<glm::dvec2> points, normals;
+    std::vector<uint32_t> body_shape( body_count );
+    std::unordered_multimap<uint64_t, uint32_t> shape_of_hash;
+
+    for( size_t i = 0; i < body_count; i++ )
+    {
+        const Shape &shape = world.shapes[i];
+        const uint64_t hash = hash_points( shape.local_points );
+
+        uint32_t found = UINT32_MAX;
+        const auto [first, last] = shape_of_hash.equal_range( hash );
+        for( auto it = first; it != last && found == UINT32_MAX; ++it )
+        {
+            const SceneFileShape &s = shapes[it->second];
+
+            if( s.vertex_count == shape.local_points.size() &&
+                !memcmp( &points[s.first_vertex], shape.local_points.data(),
+                    s.vertex_count * sizeof(glm::dvec2) ) )
+                found = it->second;
+        }
+
+        if( found == UINT32_MAX )
+        {
+            if( !fits_index( shapes.size() ) || !fits_index( points.size() + shape.local_points.size() ) )
+                return false;
+
+            found = (uint32_t)shapes.size();
+            shapes.push_back( SceneFileShape{ (uint32_t)points.size(),
+                (uint32_t)shape.local_points.size() } );
+            shape_of_hash.emplace( hash, found );
+
+            points.insert( points.end(), shape.local_points.begin(), shape.local_points.end() );
+            normals.insert( normals.end(), shape.local_normals.begin(), shape.local_normals.end() );
+        }
+
+        body_shape[i] = found;
+    }
+
+    SceneFileHeader header = {};
+    memcpy( header.magic, scene_file_magic, sizeof(header.magic) );
+    header.version = scene_file_version;
+    header.byte_order = scene_file_byte_order;
+    header.header_size = sizeof(SceneFileHeader);
+    header.body_count = body_count;
+    header.shape_count = shapes.size();
+    header.vertex_count = points.size();
+
+    uint64_t sizes[SceneSectionCount];
+    get_section_sizes( header, sizes );
+
+    uint64_t offset = align_up( sizeof(SceneFileHeader) );
+    for( int s = 0; s < SceneSectionCount; s++ )
+    {
+        header.section_offset[s] = offset;
+        offset = align_up( offset + sizes[s] );
+    }
+    header.file_size = offset;
+
+    const void *sections[SceneSectionCount] = {
+        world.x.data(), world.y.data(), world.vx.data(), world.vy.data(),
+        world.angle.data(), world.w.data(),
+        world.inv_mass.data(), world.inv_moment_of_intertia.data(), world.sleep_time.data(),
+        world.flags.data(), body_shape.data(),
+        shapes.data(), points.data(), normals.data()
+    };
+
+    FILE *out = fopen( path, "wb" );
+    if( !out )
+        return false;
+
+    offset = 0;
+    bool ok = write_section( out, &header, sizeof(header), offset );
+
+    for( int s = 0; s < SceneSectionCount && ok; s++ )
+        ok = write_section( out, sections[s], sizes[s], offset );
+
+    return fclose( out ) == 0 && ok;
+}
+
+bool load_scene( const char *path, World &world )
+{
+    const MappedFile file( path );
+    if( !file.data() || file.size() < sizeof(SceneFileHeader) )
+        return false;
+
+    SceneFileHeader header;
+    memcpy( &header, file.data(), sizeof(header) );
+
+    if( memcmp( header.magic, scene_file_magic, sizeof(header.magic) ) ||
+        header.version != scene_file_version ||
+        header.byte_order != scene_file_byte_order ||
+        header.header_size != sizeof(SceneFileHeader) ||
+        header.file_size != file.size() )
+        return false;
+
+    // liczby ograniczone rozmiarem pliku, by rozmiary sekcji się nie przepełniły
+    if( header.body_count > file.size() || header.shape_count > file.size() ||
+        header.vertex_count > file.size() ||
+        !fits_index( header.shape_count ) || !fits_index( header.vertex_count ) )
+        return false;
+
+    uint64_t sizes[SceneSectionCount];
+    get_section_sizes( header, sizes );
+
+    for( int s = 0; s < SceneSectionCount; s++ )
+    {
+        const uint64_t offset = header.section_offset[s];
+
+        if( offset % scene_file_alignment || offset > file.size() ||
+            sizes[s] > file.size() - offset )
+            return false;
+    }
+
+    auto section = [&]( SceneSection s ) { return file.data() + header.section_offset[s]; };
+
+    const size_t body_count = (size_t)header.body_count;
+    const SceneFileShape *shapes = (const SceneFileShape*)section( SceneShapes );
+    const glm::dvec2 *points = (const glm::dvec2*)section( ScenePoints );
+    const glm::dvec2 *normals = (const glm::dvec2*)section( SceneNormals );
+    const uint32_t *body_shape = (const uint32_t*)section( SceneBodyShape );
+
+    // indeksy są sprawdzane przed zmianą świata
+    for( size_t i = 0; i < header.shape_count; i++ )
+    {
+        if( shapes[i].vertex_count < 3 || shapes[i].vertex_count > max_shape_vertices ||
+            shapes[i].first_vertex > header.vertex_count ||
+            shapes[i].vertex_count > header.vertex_count - shapes[i].first_vertex ||
+            !is_valid_shape( points + shapes[i].first_vertex,
+                normals + shapes[i].first_vertex, shapes[i].vertex_count ) )
+            return false;
+    }
+
+    for( size_t i = 0; i < body_count; i++ )
+    {
+        if( body_shape[i] >= header.shape_count )
+            return false;
+    }
+
+    // stan obiektów - skończone liczby, nieujemne odwrotności mas
+    // i momentów bezwładności (0 dla nieruszalnych obiektów)
+    for( SceneSection s : { SceneX, SceneY, SceneVX, SceneVY, SceneAngle, SceneW,
+                            SceneInvMass, SceneInvMoment, SceneSleepTime } )
+    {
+        const double *column = (const double*)section( s );
+        const bool non_negative = s == SceneInvMass || s == SceneInvMoment;
+
+        for( size_t i = 0; i < body_count; i++ )
+        {
+            if( !std::isfinite( column[i] ) || ( non_negative && column[i] < 0.0 ) )
+                return false;
+        }
+    }
+
+    // kolumny stanu są kopiowane w całości
+    auto load_column = [&]( auto &column, SceneSection s )
+    {
+        using T = typename std::decay_t<decltype( column )>::value_type;
+        const T *data = (const T*)section( s );
+        column.assign( data, data + body_count );
+    };
+
+    world.clear();
+
+    load_column( world.x, SceneX );
+    load_column( world.y, SceneY );
+    load_column( world.vx, SceneVX );
+    load_column( world.vy, SceneVY );
+    load_column( world.angle, SceneAngle );
+    load_column( world.w, SceneW );
+    load_column( world.inv_mass, SceneInvMass );
+    load_column( world.inv_moment_of_intertia, SceneInvMoment );
+    load_column( world.sleep_time, SceneSleepTime );
+    load_column( world.flags, SceneFlags );
+
+    world.shapes.reserve( body_count );
+    for( size_t i = 0; i < body_count; i++ )
+    {
+        const SceneFileShape &shape = shapes[body_shape[i]];
+        const glm::dvec2 *first = points + shape.first_vertex;
+        const glm::dvec2 *first_normal = normals + shape.first_vertex;
+
+        world.shapes.emplace_back(
+            std::vector<glm::dvec2>( first, first + shape.vertex_count ),
+            std::vector<glm::dvec2>( first_normal, first_normal + shape.vertex_count ) );
+    }
+
+    return true;
+}
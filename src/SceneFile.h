@@ -0,0 +1,101 @@
+/*
+Jakub Janeczko
+nagłówek binarnego zapisu sceny
+18.10.2026
+*/
+
+#pragma once
+
+#include "World.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief binarny plik sceny - stan wszystkich obiektów świata
+ *
+ * plik składa się z nagłówka SceneFileHeader i sekcji SceneSection
+ * wyrównanych do scene_file_alignment bajtów:
+ * - tablica stanu obiektów zapisana kolumnami tak jak w World
+ *   (pozycje, prędkości, odwrotności mas, flagi, indeks kształtu),
+ * - tablica kształtów (SceneFileShape),
+ * - wspólna pula punktów i normalnych kształtów - takie same kształty
+ *   są zapisywane raz
+ *
+ * liczby są zapisane w kolejności bajtów komputera który zapisał plik,
+ * plik z inną kolejnością bajtów lub wersją jest odrzucany
+ *
+ * wczytanie mapuje plik do pamięci i kopiuje kolumny bez przetwarzania,
+ * masy, momenty bezwładności i normalne nie są ponownie obliczane
+ */
+
+constexpr char scene_file_magic[8] = { 'P', 'H', 'Y', 'S', '2', 'D', 'S', 'C' };
+constexpr uint32_t scene_file_version = 1; ///< zmieniana przy każdej zmianie układu pliku
+constexpr uint32_t scene_file_byte_order = 0x01020304; ///< zapisane w kolejności bajtów pliku
+constexpr uint64_t scene_file_alignment = 64; ///< wyrównanie sekcji w pliku [B]
+
+/**
+ * @brief sekcje pliku sceny, kolejno w pliku
+ */
+enum SceneSection {
+    SceneX, ///< double[body_count]
+    SceneY, ///< double[body_count]
+    SceneVX, ///< double[body_count]
+    SceneVY, ///< double[body_count]
+    SceneAngle, ///< double[body_count]
+    SceneW, ///< double[body_count]
+    SceneInvMass, ///< double[body_count]
+    SceneInvMoment, ///< double[body_count]
+    SceneSleepTime, ///< double[body_count]
+    SceneFlags, ///< uint32_t[body_count]
+    SceneBodyShape, ///< uint32_t[body_count], indeks w tablicy kształtów
+    SceneShapes, ///< SceneFileShape[shape_count]
+    ScenePoints, ///< double[2 * vertex_count], punkty kształtów przy kącie 0
+    SceneNormals, ///< double[2 * vertex_count], normalne krawędzi przy kącie 0
+    SceneSectionCount
+};
+
+/**
+ * @brief nagłówek pliku sceny
+ */
+struct SceneFileHeader {
+    char magic[8]; ///< scene_file_magic
+    uint32_t version; ///< scene_file_version
+    uint32_t byte_order; ///< scene_file_byte_order
+    uint64_t header_size; ///< sizeof(SceneFileHeader)
+    uint64_t file_size; ///< rozmiar całego pliku [B]
+
+    uint64_t body_count; ///< liczba obiektów
+    uint64_t shape_count; ///< liczba różnych kształtów
+    uint64_t vertex_count; ///< liczba punktów we wspólnej puli
+
+    uint64_t section_offset[SceneSectionCount]; ///< początki sekcji od początku pliku [B]
+};
+
+/**
+ * @brief kształt w pliku sceny - fragment wspólnej puli punktów
+ */
+struct SceneFileShape {
+    uint32_t first_vertex; ///< indeks pierwszego punktu w puli
+    uint32_t vertex_count; ///< liczba punktów kształtu
+};
+
+/**
+ * @brief zapisuje wszystkie obiekty świata do pliku sceny
+ *
+ * @return false jeżeli nie udało się zapisać pliku
+ */
+bool save_scene( const char *path, const World &world );
+
+/**
+ * @brief zastępuje obiekty świata obiektami z pliku sceny
+ *
+ * gdy plik nie istnieje, jest uszkodzony lub ma inną wersję
+ * świat nie zostaje zmieniony. Za uszkodzony uznawany jest też plik
+ * z kształtem niewypukłym lub o wierzchołkach zgodnie z ruchem wskazówek
+ * zegara, z nieskończonym lub nieliczbowym stanem obiektu albo z ujemną
+ * odwrotnością masy lub momentu bezwładności
+ *
+ * @return false jeżeli nie udało się wczytać pliku
+ */
+bool load_scene( const char *path, World &world );
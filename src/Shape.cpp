@@ -0,0 +1,139 @@
+/*
+Jakub Janeczko
+kształt obiektu i odcinek
+18.10.2026
+*/
+
+#include "Shape.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <limits>
+#include <assert.h>
+
+// obrót o 90 stopni w lewo
+static glm::dvec2 rot90( const glm::dvec2 &a )
+{
+    return glm::dvec2{ -a.y, a.x };
+}
+
+Shape::Shape( std::vector<glm::dvec2> points )
+    : local_points( std::move( points ) )
+{
+    // oblicz normalne krawędzi
+    for( size_t i = 0; i < local_points.size(); i++ )
+    {
+        const Edge edge{ local_points[i],
+                         local_points[i == local_points.size() - 1 ? 0 : i+1] };
+
+        local_normals.push_back( edge.get_normal() );
+    }
+}
+
+Shape::Shape( std::vector<glm::dvec2> points, std::vector<glm::dvec2> normals )
+    : local_points( std::move( points ) ), local_normals( std::move( normals ) )
+{
+    assert( local_points.size() == local_normals.size() );
+}
+
+void Shape::update_cache( double angle ) const
+{
+    const double cos_angle = cos( angle ),
+                 sin_angle = sin( angle );
+
+    const glm::dmat2 rot_angle{
+         cos_angle, sin_angle,
+        -sin_angle, cos_angle
+    };
+
+    const double inf = std::numeric_limits<double>::infinity();
+
+    points_cache.resize( local_points.size() );
+    normals_cache.resize( local_normals.size() );
+    aabb_cache = AABB{ glm::dvec2{ inf, inf }, glm::dvec2{ -inf, -inf } };
+
+    for( size_t i = 0; i < local_points.size(); i++ )
+    {
+        const glm::dvec2 point = rot_angle * local_points[i];
+
+        points_cache[i] = point;
+        aabb_cache.min = glm::min( aabb_cache.min, point );
+        aabb_cache.max = glm::max( aabb_cache.max, point );
+    }
+
+    for( size_t i = 0; i < local_normals.size(); i++ )
+        normals_cache[i] = rot_angle * local_normals[i];
+
+    cache_angle = angle;
+    cache_valid = true;
+}
+
+const std::vector<glm::dvec2> &Shape::get_points( double angle ) const
+{
+    if( !cache_valid || cache_angle != angle )
+        update_cache( angle );
+
+    return points_cache;
+}
+
+const std::vector<glm::dvec2> &Shape::get_normals( double angle ) const
+{
+    if( !cache_valid || cache_angle != angle )
+        update_cache( angle );
+
+    return normals_cache;
+}
+
+AABB Shape::get_aabb( const glm::dvec2 &center, double angle ) const
+{
+    if( !cache_valid || cache_angle != angle )
+        update_cache( angle );
+
+    return AABB{ center + aabb_cache.min, center + aabb_cache.max };
+}
+
+Polygon Shape::get_polygon( const glm::dvec2 &center, double angle ) const
+{
+    if( !cache_valid || cache_angle != angle )
+        update_cache( angle );
+
+    return Polygon{ center, points_cache, normals_cache };
+}
+
+Edge Polygon::get_closest_edge( const glm::dvec2 &point ) const
+{
+    const glm::dvec2 pt = point - center;
+
+    for( size_t i = 0; i < points.size() - 1; i++ )
+    {
+        // punkt pomiędzy dwoma wierzchołkami
+        if( vec_cross( points[i], pt ) >= 0 &&
+            vec_cross( pt, points[i+1] ) >= 0 )
+            return { center + points[i], center + points[i+1] };
+    }
+
+    assert(
+        vec_cross( points.back(), pt ) >= 0 &&
+        vec_cross( pt, points.front() ) >= 0
+    );
+
+    return { center + points.back(), center + points.front() };
+}
+
+bool Polygon::is_point_inside( const glm::dvec2 &p ) const
+{
+    const Edge closest_edge = get_closest_edge( p );
+    const double dist = closest_edge.signed_distance( p );
+    return dist <= 0;
+}
+
+double Edge::signed_distance( const glm::dvec2 &p ) const
+{
+    return glm::dot( p - a, get_normal() );
+}
+
+glm::dvec2 Edge::get_normal() const
+{
+    return glm::normalize( -rot90( b - a ) );
+}
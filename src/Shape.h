@@ -0,0 +1,192 @@
+/*
+Jakub Janeczko
+nagłówek kształtu obiektu, odcinka i AABB
+18.10.2026
+*/
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <stdint.h>
+
+/**
+ * @brief największa liczba wierzchołków kształtu - indeks krawędzi musi
+ *        zmieścić się w 31 bitach identyfikatora punktu kontaktu
+ */
+constexpr uint32_t max_shape_vertices = 1u << 31;
+
+/**
+ * \brief skierowany odcinek
+ */
+class Edge
+{
+public:
+    glm::dvec2 a, b;
+
+    /**
+     * @brief oblicza odległość ze znakiem punktu od prostej a-b
+     * 
+     * zwraca dodatnią wartość po jej lewej stronie patrząc się z a do b
+     * równą zeru gdy punkt jest na prostej
+     * a ujemną w przeciwnym przypadku
+     * 
+     * mkduł zwrócowaj wartości jest równy odległości kartezjańskiej punktu od prostej
+     * 
+     * @param p punkt do rozpatrzenia odległości
+     * @return double odległość ze znakiem prostej od punktu
+     */
+    double signed_distance( const glm::dvec2 &p ) const;
+
+
+    /**
+     * @brief oblicza wektor normalny do odcinka
+     * 
+     * wektor normalny skierowany jest w 'lewo' patrząc się z a do b
+     * 
+     * @param p punkt do rozpatrzenia odległości
+     * @return glm::dvec2 wektor normalny do odcinka
+     */
+    glm::dvec2 get_normal() const;
+};
+
+/**
+ * \brief prostokąt o bokach równoległych do osi (axis aligned bounding box)
+ */
+struct AABB
+{
+    glm::dvec2 min; ///< lewy dolny róg [m]
+    glm::dvec2 max; ///< prawy górny róg [m]
+
+    /**
+     * @brief sprawdza czy dwa AABB mają część wspólną
+     * 
+     * @return true jeżeli prostokąty się przecinają lub stykają
+     * @return false w przeciwnym przypadku
+     */
+    bool overlaps( const AABB &o ) const
+    {
+        return glm::all(
+                glm::lessThanEqual( min, o.max ) &&
+                glm::lessThanEqual( o.min, max )
+            );
+    }
+};
+
+// AABB w tablicy można wczytać jako 4 kolejne liczby (min.x, min.y, max.x, max.y)
+static_assert( sizeof(AABB) == 4 * sizeof(double), "AABB musi być ciągły" );
+
+/**
+ * @brief wielokąt wypukły w obecnym położeniu obiektu
+ * 
+ * widok na punkty i normalne obiektu, z którego korzysta wąska faza -
+ * jest ważny dopóki kąt obiektu się nie zmieni
+ */
+struct Polygon {
+    glm::dvec2 center; ///< pozycja środka obiektu [m]
+    const std::vector<glm::dvec2> &points; ///< obrócone punkty względem środka [m]
+    const std::vector<glm::dvec2> &normals; ///< obrócone zewnętrzne normalne krawędzi
+
+    /**
+     * @brief znajduje krawędź która jest najbliżej punktu
+     * 
+     * zwraca Edge tak że dodatnia odległość jest na zewnątrz obiektu
+     * 
+     * @param point punkt
+     * @return Edge 
+     */
+    Edge get_closest_edge( const glm::dvec2 &point ) const;
+
+    /**
+     * @brief sprawdza czy punkt jest we wnętrzu wielokąta
+     * 
+     * @param p punkt
+     * @return true jeżeli p jest we wnętrzu wielokąta
+     * @return false w przeciwnym przypadku
+     */
+    bool is_point_inside( const glm::dvec2 &p ) const;
+};
+
+/**
+ * @brief kształt obiektu - wielokąt wypukły względem środka obiektu
+ * 
+ * nie zmienia się w trakcie symulacji, pamięta jedynie punkty obrócone
+ * o ostatnio użyty kąt. Zapytania o ten sam kąt tylko odczytują pamięć
+ * podręczną, więc po jej obliczeniu mogą być wykonywane przez wiele wątków
+ */
+class Shape {
+public:
+    Shape() = default;
+
+    /**
+     * @brief tworzy kształt z punktów względem środka zawiniętych odwrotnie
+     *        do ruchu wskazówek zegara i oblicza normalne krawędzi
+     */
+    explicit Shape( std::vector<glm::dvec2> points );
+
+    /**
+     * @brief tworzy kształt z punktów i obliczonych wcześniej normalnych
+     *        krawędzi (np. wczytanych z pliku sceny)
+     */
+    Shape( std::vector<glm::dvec2> points, std::vector<glm::dvec2> normals );
+
+    /**
+     * @brief pozycje punktów względem środka przy kącie równym 0 [m]
+     */
+    std::vector<glm::dvec2> local_points;
+
+    /**
+     * @brief zewnętrzne normalne krawędzi przy kącie równym 0
+     * 
+     * normalna i odpowiada krawędzi od punktu i do punktu i+1
+     */
+    std::vector<glm::dvec2> local_normals;
+
+    /**
+     * @brief zwraca punkty obrócone o kąt angle [m]
+     * 
+     * punkty są obliczane leniwie z local_points i pamiętane aż do
+     * zapytania o inny kąt
+     */
+    const std::vector<glm::dvec2> &get_points( double angle ) const;
+
+    /**
+     * @brief zwraca zewnętrzne normalne krawędzi obrócone o kąt angle
+     * 
+     * korzysta z tej samej pamięci podręcznej co get_points
+     */
+    const std::vector<glm::dvec2> &get_normals( double angle ) const;
+
+    /**
+     * @brief zwraca AABB kształtu w pozycji center i obróconego o kąt angle
+     * 
+     * korzysta z tej samej pamięci podręcznej co get_points
+     */
+    AABB get_aabb( const glm::dvec2 &center, double angle ) const;
+
+    /**
+     * @brief zwraca wielokąt w pozycji center i obrócony o kąt angle
+     */
+    Polygon get_polygon( const glm::dvec2 &center, double angle ) const;
+
+private:
+    mutable std::vector<glm::dvec2> points_cache; ///< obrócone punkty
+    mutable std::vector<glm::dvec2> normals_cache; ///< obrócone normalne
+    mutable AABB aabb_cache; ///< AABB obróconych punktów względem środka
+    mutable double cache_angle = 0.0; ///< kąt dla którego obliczono pamięć podręczną
+    mutable bool cache_valid = false; ///< czy pamięć podręczna została obliczona
+
+    /**
+     * @brief oblicza obrócone punkty, normalne i AABB
+     */
+    void update_cache( double angle ) const;
+};
+
+/**
+ * @brief oblicza trzecią współrzędną cross-produktu pomiędzy wektorami
+ */
+inline double vec_cross( const glm::dvec2 &a, const glm::dvec2 &b )
+{
+    return a.x*b.y - a.y*b.x;
+}
\ No newline at end of file
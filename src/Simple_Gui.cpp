@@ -5,6 +5,7 @@ klasa GUI
 */
 
 #include "Simple_Gui.h"
+#include "SceneFile.h"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -12,7 +13,10 @@ klasa GUI
 
 #define _USE_MATH_DEFINES
 #include <math.h>
+#include <stdio.h>
 #include <stdexcept>
+#include <algorithm>
+#include <tuple>
 
 const glm::u8vec4 white( 255, 255, 255, 255 ),
                   red( 255, 0, 0, 255 );
@@ -23,24 +27,158 @@ Simple_Gui::Simple_Gui( Simple_PhysicsEngine *engine )
     if( !engine ) 
         throw std::invalid_argument(u8"Simple_Gui musi otrzymać Simple_PhysicsEngine");
 
+    params = *engine;
+
     camPos = glm::dvec2( 0.0 );
     camZoom = 10.;
 
     bTriangles = false;
+    profiler_enabled = Profiler::is_enabled();
+    scene_message = std::make_shared<std::atomic<const char*>>( nullptr );
+
+    for( auto &history : stats_history )
+        std::fill( std::begin( history ), std::end( history ), 0.f );
+    stats_history_offset = 0;
+    stats_history_tick = UINT64_MAX;
+    interpolate_objects = true;
     object_selected = false;
+    object_revision = 0;
     creation_mode = false;
     error_popup = false;
     pulling_scene = false;
 }
 
-static void imgui_double_slider( const char *label, double &val, double min, double max )
+static bool imgui_double_slider( const char *label, double &val, double min, double max )
+{
+    return ImGui::SliderScalar(label, ImGuiDataType_Double, &val, &min, &max );
+}
+
+void Simple_Gui::stats_plots( const WorldSnapshot &world )
 {
-    ImGui::SliderScalar(label, ImGuiDataType_Double, &val, &min, &max );
+    const struct {
+        const char *name;
+        uint64_t StepStats::*value;
+    } counters[stats_counter_count] = {
+        { u8"Scałkowane obiekty", &StepStats::bodies_integrated },
+        { u8"Testy AABB", &StepStats::aabb_tests },
+        { u8"Pary z szerokiej fazy", &StepStats::candidate_pairs },
+        { u8"Wywołania wąskiej fazy", &StepStats::narrowphase_calls },
+        { u8"Kontakty", &StepStats::contacts },
+        { u8"Impulsy", &StepStats::impulses },
+        { u8"Korekcje przenikania", &StepStats::position_corrections },
+        { u8"Alokacje pamięci", &StepStats::allocations },
+    };
+
+    const StepStats &stats = world.status.stats;
+    const double substeps = (double)std::max<uint64_t>( 1, stats.substeps );
+
+    // dodaj nowy krok do historii
+    if( world.tick != stats_history_tick )
+    {
+        for( int c = 0; c < stats_counter_count; c++ )
+            stats_history[c][stats_history_offset] = (float)( stats.*counters[c].value / substeps );
+
+        stats_history_offset = ( stats_history_offset + 1 ) % stats_history_size;
+        stats_history_tick = world.tick;
+    }
+
+    if( !ImGui::CollapsingHeader(u8"Liczniki kroku (na podkrok)") )
+        return;
+
+    for( int c = 0; c < stats_counter_count; c++ )
+    {
+        const float *history = stats_history[c];
+        const float max_value = *std::max_element( history, history + stats_history_size );
+
+        char overlay[64];
+        snprintf( overlay, sizeof( overlay ), "%.0f (maks. %.0f)",
+            stats.*counters[c].value / substeps, max_value );
+
+        ImGui::PlotLines( counters[c].name, history, stats_history_size,
+            stats_history_offset, overlay, 0.f, max_value * 1.1f + 1.f, ImVec2( 0, 40 ) );
+    }
+}
+
+void Simple_Gui::profiler_window()
+{
+    if( !ImGui::Begin(u8"Profiler") )
+    {
+        ImGui::End();
+        return;
+    }
+
+    if( ImGui::Checkbox(u8"Mierz czasy stref", &profiler_enabled ) )
+        Profiler::set_enabled( profiler_enabled );
+
+    if( ImGui::Button(u8"Zapisz ślad (phys2D_trace.json)") )
+        trace_message = Profiler::write_chrome_trace( "phys2D_trace.json" ) ?
+            u8"zapisano, otwórz w chrome://tracing lub ui.perfetto.dev" :
+            u8"nie udało się zapisać pliku";
+
+    if( !trace_message.empty() )
+        ImGui::TextUnformatted( trace_message.c_str() );
+
+    // zgrupuj strefy z ostatniej sekundy po wątku i nazwie
+    const uint64_t second_ns = 1000000000;
+    const uint64_t now = Profiler::now();
+
+    profile_records.clear();
+    Profiler::collect( profile_records, now > second_ns ? now - second_ns : 0 );
+
+    zone_stats.clear();
+    for( const ProfileRecord &r : profile_records )
+    {
+        auto it = std::find_if( zone_stats.begin(), zone_stats.end(),
+            [&]( const ZoneStats &z ) { return z.thread == r.thread && z.name == r.name; } );
+
+        if( it == zone_stats.end() )
+        {
+            zone_stats.push_back( ZoneStats{ r.name, r.thread, r.depth, r.start_ns, 0, 0, 0 } );
+            it = zone_stats.end() - 1;
+        }
+
+        const uint64_t duration = r.end_ns - r.start_ns;
+        it->first_start_ns = std::min( it->first_start_ns, r.start_ns );
+        it->depth = std::min( it->depth, r.depth );
+        it->count++;
+        it->total_ns += duration;
+        it->max_ns = std::max( it->max_ns, duration );
+    }
+
+    std::sort( zone_stats.begin(), zone_stats.end(),
+        []( const ZoneStats &a, const ZoneStats &b )
+        {
+            // strefa nadrzędna zaczyna się przed podrzędnymi
+            return std::tie( a.thread, a.first_start_ns, a.depth ) <
+                std::tie( b.thread, b.first_start_ns, b.depth );
+        } );
+
+    ImGui::Text(u8"%-36s %8s %10s %10s %10s", u8"strefa (ostatnia sekunda)",
+        u8"wywołań", u8"śr. [ms]", u8"maks. [ms]", u8"ms/s");
+
+    uint32_t last_thread = UINT32_MAX;
+    for( const ZoneStats &z : zone_stats )
+    {
+        if( z.thread != last_thread )
+        {
+            ImGui::Separator();
+            ImGui::Text(u8"wątek %u", z.thread );
+            last_thread = z.thread;
+        }
+
+        ImGui::Text( "%*s%-*s %8zu %10.3f %10.3f %10.2f",
+            (int)z.depth * 2, "", 36 - (int)z.depth * 2, z.name, z.count,
+            z.total_ns / 1e6 / z.count, z.max_ns / 1e6, z.total_ns / 1e6 );
+    }
+
+    ImGui::End();
 }
 
 renderer_info
-Simple_Gui::handle_gui( std::vector<PhysicsObject> &objs, double dt )
+Simple_Gui::handle_gui( const WorldSnapshot &world, WorldCommandQueue &commands, double dt )
 {
+    PROFILE_ZONE( "Simple_Gui::handle_gui" );
+
     renderer_info ri;
 
     ImGuiIO &io = ImGui::GetIO();
@@ -54,12 +192,39 @@ Simple_Gui::handle_gui( std::vector<PhysicsObject> &objs, double dt )
     const glm::dvec2 world_mouse_pos = (rel_mouse_pos / camZoom) + camPos;
 
     ImGui::ShowMetricsWindow();
+    profiler_window();
 
     if( ImGui::Begin(u8"Główne okno") )
     {
         ImGui::Text(u8"Pozycja kamery: x=%g, y=%g", camPos.x, camPos.y );
         ImGui::Text(u8"Przybliżenie: %g px/m", camZoom );
         ImGui::Checkbox(u8"Wypełniać obiekty?", &bTriangles );
+        ImGui::Checkbox(u8"Interpolować położenia obiektów?", &interpolate_objects );
+
+        // świat należy do wątku symulacji - zapis i wczytanie są zmianami świata
+        if( ImGui::Button(u8"Zapisz scenę (phys2D_scene.bin)") )
+            commands.push( [message = scene_message]( World &world )
+            {
+                message->store( save_scene( "phys2D_scene.bin", world ) ?
+                    u8"zapisano scenę" : u8"nie udało się zapisać sceny" );
+            } );
+
+        ImGui::SameLine();
+
+        if( ImGui::Button(u8"Wczytaj scenę") )
+        {
+            object_selected = false;
+            pulling_object = false;
+
+            commands.push( [message = scene_message]( World &world )
+            {
+                message->store( load_scene( "phys2D_scene.bin", world ) ?
+                    u8"wczytano scenę" : u8"nie udało się wczytać sceny" );
+            } );
+        }
+
+        if( const char *message = scene_message->load() )
+            ImGui::TextUnformatted( message );
 
         bool last_creation_mode = creation_mode;
         ImGui::Checkbox(u8"Menu tworzenia obiektów", &creation_mode );
@@ -74,36 +239,137 @@ Simple_Gui::handle_gui( std::vector<PhysicsObject> &objs, double dt )
 
     if( ImGui::Begin( u8"Paramety silnika fizyki") )
     {
-        imgui_double_slider(u8"Siła grawitacji [m/s2]", engine->gravity, 0, 100 );
-        imgui_double_slider(u8"Składowa pomniejszania prędkości", 
-            engine->dump_velocity_factor, 0, 0.1);
-        imgui_double_slider(u8"Składowa pomniejszania prędkości kątowej",
-            engine->dump_angular_velocity_factor, 0, 0.1 );
-        imgui_double_slider(u8"Spręrzystość odbicia (ile energi zostaje przy odbiciu)",
-            engine->restitution, 0, 1 );
+        // silnik działa w wątku symulacji - parametry są zmieniane
+        // na kopii i przekazywane przez kolejkę zmian
+        bool params_changed = false;
+
+        params_changed |= imgui_double_slider(u8"Siła grawitacji [m/s2]",
+            params.gravity, 0, 100 );
+        params_changed |= imgui_double_slider(u8"Składowa pomniejszania prędkości", 
+            params.dump_velocity_factor, 0, 0.1);
+        params_changed |= imgui_double_slider(u8"Składowa pomniejszania prędkości kątowej",
+            params.dump_angular_velocity_factor, 0, 0.1 );
+        params_changed |= imgui_double_slider(
+            u8"Spręrzystość odbicia (ile energi zostaje przy odbiciu)",
+            params.restitution, 0, 1 );
         
-        ImGui::SliderInt(u8"Liczba podkroków symulacji",
-            &engine->time_subdivision, 1, 1024 );
+        params_changed |= ImGui::SliderInt(u8"Liczba podkroków symulacji",
+            &params.time_subdivision, 1, 1024 );
+        params_changed |= ImGui::SliderInt(u8"Iteracje prędkości kontaktów",
+            &params.velocity_iterations, 1, 64 );
+        params_changed |= ImGui::SliderInt(u8"Iteracje usuwania przenikania",
+            &params.position_iterations, 0, 64 );
+
+        const char *broadphase_names[] = {
+            u8"Sortowanie i zamiatanie",
+            u8"Dynamiczne drzewo AABB",
+            u8"Haszowana siatka"
+        };
+
+        int broadphase_type = params.broadphase_type;
+        if( ImGui::Combo(u8"Szeroka faza", &broadphase_type,
+                broadphase_names, IM_ARRAYSIZE(broadphase_names)) )
+        {
+            params.broadphase_type = (Simple_PhysicsEngine::BroadphaseType)broadphase_type;
+            params_changed = true;
+        }
+
+        const char *narrowphase_names[] = {
+            u8"Krawędzie i punkty",
+            u8"Oś rozdzielająca (SAT)",
+            u8"GJK i EPA"
+        };
+
+        int narrowphase_type = params.narrowphase_type;
+        if( ImGui::Combo(u8"Wąska faza", &narrowphase_type,
+                narrowphase_names, IM_ARRAYSIZE(narrowphase_names)) )
+        {
+            params.narrowphase_type = (Simple_PhysicsEngine::NarrowphaseType)narrowphase_type;
+            params_changed = true;
+        }
+
+        int thread_count = (int)params.thread_count;
+        if( ImGui::SliderInt(u8"Liczba wątków", &thread_count,
+                1, (int)JobSystem::get_hardware_threads()) )
+        {
+            params.thread_count = (unsigned)thread_count;
+            params_changed = true;
+        }
+
+        // można wybrać tylko zestawy instrukcji obsługiwane przez procesor
+        const char *simd_level_names[] = {
+            get_simd_level_name( SimdLevel::Scalar ),
+            get_simd_level_name( SimdLevel::SSE2 ),
+            get_simd_level_name( SimdLevel::AVX2 )
+        };
+
+        int simd_level = (int)params.simd_level;
+        if( ImGui::Combo(u8"Instrukcje całkowania", &simd_level,
+                simd_level_names, (int)get_simd_level() + 1) )
+        {
+            params.simd_level = (SimdLevel)simd_level;
+            params_changed = true;
+        }
+
+        params_changed |= ImGui::Checkbox(u8"Ciepły start kontaktów", &params.warm_starting );
+
+        params_changed |= ImGui::Checkbox(u8"Usypianie spoczywających obiektów",
+            &params.sleeping_enabled );
+        params_changed |= imgui_double_slider(u8"Próg prędkości uśpienia [m/s]",
+            params.sleep_linear_velocity, 0, 1 );
+        params_changed |= imgui_double_slider(u8"Próg prędkości kątowej uśpienia [rad/s]",
+            params.sleep_angular_velocity, 0, 1 );
+        params_changed |= imgui_double_slider(u8"Czas do uśpienia [s]",
+            params.time_to_sleep, 0, 5 );
+
+        if( params_changed )
+        {
+            commands.push( [engine = engine, params = params]( World& )
+            {
+                static_cast<Simple_PhysicsEngineParameters&>( *engine ) = params;
+            } );
+        }
+
+        const EngineStatus &status = world.status;
+
+        ImGui::Text(u8"Krok symulacji: %llu (%.3f ms)",
+            (unsigned long long)world.tick, world.tick_time * 1000.0 );
+        ImGui::Text(u8"Uśpione obiekty: %zu", status.sleeping_count );
+        ImGui::Text(u8"Kolory kontaktów: %zu", status.color_count );
+        ImGui::Text(u8"Pary z szerokiej fazy w podkroku: min=%zu, max=%zu",
+            status.min_pairs, status.max_pairs );
+        ImGui::Text(u8"Alokacje pamięci w kroku: %llu",
+            (unsigned long long)status.tick_allocations );
+
+        stats_plots( world );
     }
     ImGui::End();
 
+    // po zmianie zbioru obiektów indeks może wskazywać inny obiekt
+    if( object_selected && object_revision != world.revision )
+    {
+        object_selected = false;
+        pulling_object = false;
+    }
+
     if( object_selected )
     {
         if( ImGui::Begin(u8"Parametry symulowanego obiektu", &object_selected) )
         {
-            PhysicsObject &obj = objs[object_idx];
+            const uint32_t i = object_idx;
 
             ImGui::Value("Index", object_idx);
-            ImGui::Value(u8"Odwrotność masy [1/kg]", (float)obj.inv_mass);
+            ImGui::Value(u8"Odwrotność masy [1/kg]", (float)world.inv_mass[i]);
             ImGui::Value(u8"Odwrotność momentu bezwładności [1/(kg*m2)]", 
-                (float)obj.inv_moment_of_intertia);
-
-            ImGui::Text(u8"Środek [m]: x=%g, y=%g", obj.center.x, obj.center.y );
-            ImGui::Text(u8"Kąt [rad]: %g", obj.angle);
-            ImGui::Text(u8"Prędkość [m/s]: x=%g, y=%g", obj.velocity.x, obj.velocity.y );
-            ImGui::Text(u8"Prędkość kątowa [rad/s]: %g", obj.ang_velocity );
-            ImGui::Text(u8"Flagi: %s", 
-                obj.flags & PhysicsObject::Immovable ? u8"nieruszalny" : u8"");
+                (float)world.inv_moment_of_intertia[i]);
+
+            ImGui::Text(u8"Środek [m]: x=%g, y=%g", world.x[i], world.y[i] );
+            ImGui::Text(u8"Kąt [rad]: %g", world.angle[i]);
+            ImGui::Text(u8"Prędkość [m/s]: x=%g, y=%g", world.vx[i], world.vy[i] );
+            ImGui::Text(u8"Prędkość kątowa [rad/s]: %g", world.w[i] );
+            ImGui::Text(u8"Flagi: %s %s", 
+                world.flags[i] & PhysicsObject::Immovable ? u8"nieruszalny" : u8"",
+                world.flags[i] & PhysicsObject::Sleeping ? u8"uśpiony" : u8"");
         }
         ImGui::End();
     }
@@ -116,15 +382,16 @@ Simple_Gui::handle_gui( std::vector<PhysicsObject> &objs, double dt )
         try
         {
             PhysicsObject new_obj( point_cloud, density, flags_created_item );
+            const std::vector<glm::dvec2> &new_points = new_obj.get_points();
 
-            ri.additional_lines.push_back( new_obj.points[0] + new_obj.center );
-            for( size_t i = 1; i < new_obj.points.size(); i++ )
+            ri.additional_lines.push_back( new_points[0] + new_obj.center );
+            for( size_t i = 1; i < new_points.size(); i++ )
             {
-                const glm::dvec2 &pt = new_obj.points[i];
+                const glm::dvec2 &pt = new_points[i];
                 ri.additional_lines.push_back( pt + new_obj.center );
                 ri.additional_lines.push_back( pt + new_obj.center );
             }
-            ri.additional_lines.push_back( new_obj.points[0] + new_obj.center );
+            ri.additional_lines.push_back( new_points[0] + new_obj.center );
         }
         catch(const std::exception&)
         {
@@ -145,7 +412,8 @@ Simple_Gui::handle_gui( std::vector<PhysicsObject> &objs, double dt )
             {
                 try
                 {
-                    objs.emplace_back( point_cloud, density, flags_created_item );
+                    const PhysicsObject new_obj( point_cloud, density, flags_created_item );
+                    commands.push( [new_obj]( World &world ) { world.add( new_obj ); } );
                     point_cloud.clear();
                 }
                 catch(const std::exception& e)
@@ -184,16 +452,27 @@ Simple_Gui::handle_gui( std::vector<PhysicsObject> &objs, double dt )
         {
             bool object_found = false;
 
-            for( size_t i = 0; i < objs.size(); i++ )
-                if( objs[i].is_point_inside_object( world_mouse_pos ) )
+            // najpierw wsadowo znajdź obiekty których AABB zawiera kursor
+            picking_aabbs.resize( world.size() );
+            for( uint32_t i = 0; i < world.size(); i++ )
+                picking_aabbs[i] = world.get_aabb( i );
+
+            picking_array.assign( picking_aabbs );
+            picking_hits.clear();
+            find_overlaps( AABB{ world_mouse_pos, world_mouse_pos },
+                picking_array, 0, picking_array.size(), picking_hits );
+
+            for( const uint32_t i : picking_hits )
+                if( world.get_polygon( i ).is_point_inside( world_mouse_pos ) )
                 {
                     object_selected = true;
-                    object_idx = (uint32_t)i;
+                    object_idx = i;
+                    object_revision = world.revision;
                     object_found = true;
                     
                     pulling_object = true;
-                    pull_pos = world_mouse_pos - objs[i].center;
-                    pull_last_angle = objs[i].angle;
+                    pull_pos = world_mouse_pos - world.get_center( i );
+                    pull_last_angle = world.angle[i];
 
                     object_found = true;
                     break;
@@ -225,7 +504,14 @@ Simple_Gui::handle_gui( std::vector<PhysicsObject> &objs, double dt )
         {
             if( object_selected )
             {
-                objs.erase(objs.begin() + object_idx);
+                // polecenie jest pomijane, jeżeli przed jego wykonaniem
+                // zmienił się zbiór obiektów, bo indeks wskazywałby inny obiekt
+                const uint32_t i = object_idx;
+                commands.push( [i, revision = object_revision]( World &world )
+                {
+                    if( world.get_revision() == revision )
+                        world.remove( i );
+                } );
                 object_selected = false;
                 pulling_object = false;
             }
@@ -239,9 +525,9 @@ Simple_Gui::handle_gui( std::vector<PhysicsObject> &objs, double dt )
         else
         {
             // calculate pull force
-            PhysicsObject &obj = objs[object_idx];
+            const uint32_t i = object_idx;
 
-            const double d_angle = obj.angle - pull_last_angle;
+            const double d_angle = world.angle[i] - pull_last_angle;
             
             const double c_a = cos( d_angle ),
                          s_a = sin( d_angle );
@@ -252,17 +538,23 @@ Simple_Gui::handle_gui( std::vector<PhysicsObject> &objs, double dt )
             };
 
             pull_pos = rot_d_angle * pull_pos;
-            pull_last_angle = obj.angle;
+            pull_last_angle = world.angle[i];
 
             const double pull_factor = 100;
 
-            const glm::dvec2 pull_glob_pos = pull_pos + obj.center;
+            const glm::dvec2 pull_glob_pos = pull_pos + world.get_center( i );
 
             const glm::dvec2 pullArrowDir = world_mouse_pos - pull_glob_pos;
 
             const glm::dvec2 pull_force = pullArrowDir * pull_factor;
 
-            obj.add_impulse( pull_pos, pull_force * dt );
+            const glm::dvec2 pull_impulse = pull_force * dt;
+            commands.push( [i, revision = object_revision,
+                pull_pos = pull_pos, pull_impulse]( World &world )
+            {
+                if( world.get_revision() == revision )
+                    world.add_impulse( i, pull_pos, pull_impulse );
+            } );
 
             const double pullArrowLen = glm::length( pullArrowDir ) * 0.2;
 
@@ -284,7 +576,7 @@ Simple_Gui::handle_gui( std::vector<PhysicsObject> &objs, double dt )
                 {-a2, h1}
             };
             
-            const glm::vec3 arrow_start( obj.center + pull_pos, 0.0f );
+            const glm::vec3 arrow_start( pull_glob_pos, 0.0f );
 
             const glm::mat4 transform_arrow = glm::rotate( 
                     glm::translate(
@@ -304,8 +596,9 @@ Simple_Gui::handle_gui( std::vector<PhysicsObject> &objs, double dt )
     ri.camPos = camPos;
     ri.camZoom = camZoom;
     ri.fill_objects = bTriangles;
+    ri.interpolate_objects = interpolate_objects;
 
-    for( size_t i = 0; i < objs.size(); i++ )
+    for( size_t i = 0; i < world.size(); i++ )
         ri.object_colors.push_back(
             object_selected && object_idx == i ?
                 red : white
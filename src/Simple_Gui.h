@@ -8,11 +8,15 @@ header klasy GUI
 
 #include "interfaces.h"
 #include "Simple_PhysicsEngine.h"
+#include "AABBArray.h"
+#include "Profiler.h"
 
 #include <glm/glm.hpp>
 
 #include <vector>
 #include <string>
+#include <memory>
+#include <atomic>
 
 /**
  * @brief GUI z możliwością manipulacji Simple_PhysicsEngine
@@ -29,20 +33,24 @@ public:
     /**
      * @brief tworzy GUI operujące na podanym silniku
      * 
-     * @param engine silnik fizyki do modyfikacji parametrów
+     * @param engine silnik fizyki do modyfikacji parametrów, jego
+     *               parametry są zmieniane przez kolejkę zmian świata
      */
     Simple_Gui( Simple_PhysicsEngine *engine );
 
-    virtual renderer_info handle_gui( std::vector<PhysicsObject> &objs, double dt );
+    virtual renderer_info handle_gui( const WorldSnapshot &world,
+        WorldCommandQueue &commands, double dt );
 
 private:
     glm::dvec2 camPos;
     double camZoom;
 
     bool bTriangles;
+    bool interpolate_objects;
 
     bool object_selected;
     uint32_t object_idx;
+    uint64_t object_revision; ///< numer zmiany świata, w którym obiekt został wybrany
 
     bool pulling_object;
     glm::dvec2 pull_pos;
@@ -58,5 +66,48 @@ private:
 
     bool pulling_scene;
 
+    std::vector<AABB> picking_aabbs; ///< AABB obiektów przy wybieraniu myszą
+    AABBArray picking_array; ///< picking_aabbs w układzie do testu wsadowego
+    std::vector<uint32_t> picking_hits; ///< obiekty których AABB zawiera kursor
+
+    /**
+     * @brief czasy jednej strefy profilera w ostatniej sekundzie
+     */
+    struct ZoneStats {
+        const char *name;
+        uint32_t thread, depth;
+        uint64_t first_start_ns; ///< początek pierwszego wystąpienia, do sortowania
+        size_t count;
+        uint64_t total_ns, max_ns;
+    };
+
+    static constexpr int stats_history_size = 240; ///< liczba pamiętanych kroków
+    static constexpr int stats_counter_count = 8; ///< liczba liczników StepStats na wykresach
+
+    /**
+     * @brief historia liczników StepStats (na podkrok) w buforze cyklicznym
+     */
+    float stats_history[stats_counter_count][stats_history_size];
+    int stats_history_offset; ///< indeks najstarszej wartości
+    uint64_t stats_history_tick; ///< krok symulacji ostatnio dodany do historii
+
+    void stats_plots( const WorldSnapshot &world );
+
+    bool profiler_enabled;
+    std::string trace_message; ///< wynik ostatniego zapisu śladu
+    std::vector<ProfileRecord> profile_records; ///< strefy z ostatniej sekundy
+    std::vector<ZoneStats> zone_stats; ///< strefy pogrupowane po wątku i nazwie
+
+    void profiler_window();
+
+    /**
+     * @brief wynik ostatniego zapisu lub wczytania sceny (stały napis)
+     * 
+     * scena jest zapisywana i wczytywana w wątku symulacji,
+     * który ustawia wynik po wykonaniu zmiany
+     */
+    std::shared_ptr<std::atomic<const char*>> scene_message;
+
     Simple_PhysicsEngine *engine;
+    Simple_PhysicsEngineParameters params; ///< parametry silnika zmieniane przez GUI
 };
\ No newline at end of file
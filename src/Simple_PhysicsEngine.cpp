@@ -6,10 +6,19 @@ implementacja silnika fizyki
 
 #include "Simple_PhysicsEngine.h"
 #include "PhysicsObject.h"
+#include "World.h"
+#include "SAP_Broadphase.h"
+#include "AABBTree_Broadphase.h"
+#include "HashGrid_Broadphase.h"
+#include "AllocationCounter.h"
+#include "Narrowphase.h"
+#include "Integration.h"
+#include "Profiler.h"
 
 #include <glm/glm.hpp>
 
 #include <vector>
+#include <memory>
 #include <algorithm>
 #include <limits>
 #include <numeric>
@@ -22,210 +31,722 @@ static glm::dvec2 rot90( const glm::dvec2 &v )
     return glm::dvec2( -v.y, v.x );
 }
 
-// znajdź AABB (axis aligned bounding box) obiektu
-static std::pair<glm::dvec2, glm::dvec2> get_aabb( 
-    const PhysicsObject &obj )
+// liczby elementów przetwarzanych w jednym zadaniu systemu zadań
+constexpr size_t integration_grain = 4096;
+constexpr size_t aabb_grain = 256;
+constexpr size_t narrowphase_grain = 64;
+constexpr size_t solver_grain = 128;
+
+// obiekty które nie są symulowane
+constexpr uint32_t inactive_flags = PhysicsObject::Immovable | PhysicsObject::Sleeping;
+
+// poniżej tej prędkości zderzenia odbicie jest pomijane, by obiekty
+// leżące na sobie nie podskakiwały [m/s]
+constexpr double restitution_threshold = 0.5;
+
+// przenikanie które nie jest korygowane, by kontakt nie znikał
+// pomiędzy krokami [m]
+constexpr double linear_slop = 0.005;
+
+// jaka część przenikania jest usuwana w jednym kroku
+constexpr double position_correction_factor = 0.8;
+
+// masa efektywna - impuls potrzebny do zmiany prędkości względnej
+// w punkcie kontaktu o 1 m/s
+static double normal_mass( const Simple_PhysicsEngine::ContactConstraint &c,
+    const glm::dvec2 &rel_a, const glm::dvec2 &rel_b )
 {
-    const auto v_min = []( const glm::dvec2 &v1, const glm::dvec2 &v2 )
-    {
-        return glm::min( v1, v2 );
-    };
+    const double rn_a = vec_cross( rel_a, c.normal );
+    const double rn_b = vec_cross( rel_b, c.normal );
 
-    const auto v_max = []( const glm::dvec2 &v1, const glm::dvec2 &v2 )
-    {
-        return glm::max( v1, v2 );
-    };
+    const double angular_effect =
+        rn_a * rn_a * c.inv_moment_of_intertia_a +
+        rn_b * rn_b * c.inv_moment_of_intertia_b;
+
+    return 1.0 / ( c.inv_mass_a + c.inv_mass_b + angular_effect );
+}
+
+// prędkość względna w punkcie kontaktu wzdłuż normalnej
+// (ujemna gdy obiekty zbliżają się do siebie)
+static double normal_velocity(
+    const glm::dvec2 &vel_a, double ang_vel_a, const glm::dvec2 &rel_a,
+    const glm::dvec2 &vel_b, double ang_vel_b, const glm::dvec2 &rel_b,
+    const glm::dvec2 &normal )
+{
+    const glm::dvec2 full_vel_a = vel_a + ang_vel_a * rot90( rel_a );
+    const glm::dvec2 full_vel_b = vel_b + ang_vel_b * rot90( rel_b );
 
-    const double inf = std::numeric_limits<double>::infinity();
+    return glm::dot( full_vel_b - full_vel_a, normal );
+}
+
+// przyłóż impuls normalny (dodatni odpycha obiekty) do prędkości vel i ang_vel
+static void apply_normal_impulse( const Simple_PhysicsEngine::ContactConstraint &c,
+    glm::dvec2 &vel_a, double &ang_vel_a, const glm::dvec2 &rel_a,
+    glm::dvec2 &vel_b, double &ang_vel_b, const glm::dvec2 &rel_b,
+    double impulse )
+{
+    const glm::dvec2 p = impulse * c.normal;
 
-    return std::make_pair(
-        obj.center + std::reduce( 
-            obj.points.begin(), obj.points.end(), glm::dvec2{  inf,  inf }, v_min),
+    vel_a -= p * c.inv_mass_a;
+    ang_vel_a -= vec_cross( rel_a, p ) * c.inv_moment_of_intertia_a;
 
-        obj.center + std::reduce( 
-            obj.points.begin(), obj.points.end(), glm::dvec2{ -inf, -inf }, v_max)
-    );
+    vel_b += p * c.inv_mass_b;
+    ang_vel_b += vec_cross( rel_b, p ) * c.inv_moment_of_intertia_b;
 }
 
-bool Simple_PhysicsEngine::is_potentially_colliding( 
-    const PhysicsObject &a,
-    const PhysicsObject &b )
+// znajdź kontakt jeżeli obiekty kolidują
+bool Simple_PhysicsEngine::find_contact( 
+    const Polygon &a, 
+    const Polygon &b,
+    PairContact &contact )
 {
-    auto [a_min, a_max] = get_aabb(a);
-    auto [b_min, b_max] = get_aabb(b);
+    Manifold manifold;
+    bool colliding;
 
-    // dwa nieruszalne obiekty nie powinny kolidować
-    if( (a.flags & PhysicsObject::Immovable) &&
-        (b.flags & PhysicsObject::Immovable) )
+    switch( narrowphase_type )
+    {
+    case EdgePoint:
+        colliding = collide_edge_point( a, b, manifold );
+        break;
+    case GJK_EPA:
+        colliding = collide_gjk_epa( a, b, manifold );
+        break;
+    case SAT:
+    default:
+        colliding = collide_sat( a, b, contact.sat, manifold );
+        break;
+    }
+
+    if( !colliding )
+    {
+        contact.manifold.count = 0;
         return false;
+    }
 
-    // czy AABB kolidują
-    return glm::all(
-            glm::lessThanEqual( a_min, b_max ) &&
-            glm::lessThanEqual( b_min, a_max )
-        );
+    // przenieś skumulowane impulsy punktów znanych z poprzedniego kroku
+    if( warm_starting )
+        for( int i = 0; i < manifold.count; i++ )
+            for( int j = 0; j < contact.manifold.count; j++ )
+                if( manifold.points[i].id == contact.manifold.points[j].id )
+                {
+                    manifold.points[i].normal_impulse =
+                        contact.manifold.points[j].normal_impulse;
+                    break;
+                }
+
+    contact.manifold = manifold;
+    return true;
 }
 
-// znajdź parę krawęź a - punkt b które są najbliżej
-// czyli najkrótszą drogę by rozdzielić obiekt a od b
-// po krawędzi a 
-std::pair<Edge,glm::dvec2>
-Simple_PhysicsEngine::get_shortest_edge_point_dist( 
-    const PhysicsObject &a,
-    const PhysicsObject &b )
+void Simple_PhysicsEngine::add_constraint( const World &world,
+    uint32_t a, uint32_t b, const Manifold &manifold, double dt )
 {
-    std::vector<glm::dvec2> world_a, world_b;
-    for( const glm::dvec2 &p : a.points )
-        world_a.push_back( p + a.center );
-    
-    for( const glm::dvec2 &p : b.points )
-        world_b.push_back( p + b.center );
+    ContactConstraint &c = constraints.emplace_back();
+    c.a = a;
+    c.b = b;
+    c.normal = manifold.normal;
+    c.count = manifold.count;
+    c.inv_mass_a = world.inv_mass[a];
+    c.inv_mass_b = world.inv_mass[b];
+    c.inv_moment_of_intertia_a = world.inv_moment_of_intertia[a];
+    c.inv_moment_of_intertia_b = world.inv_moment_of_intertia[b];
+    c.dynamic_a = !( world.flags[a] & PhysicsObject::Immovable );
+    c.dynamic_b = !( world.flags[b] & PhysicsObject::Immovable );
+
+    const glm::dvec2 center_a = world.get_center( a ), center_b = world.get_center( b );
+    const glm::dvec2 vel_a = world.get_velocity( a ), vel_b = world.get_velocity( b );
+
+    for( int i = 0; i < manifold.count; i++ )
+    {
+        const ContactPoint &cp = manifold.points[i];
+        ContactConstraint::Point &p = c.points[i];
+
+        p.rel_a = cp.point - center_a;
+        p.rel_b = cp.point - center_b;
+        p.normal_mass = normal_mass( c, p.rel_a, p.rel_b );
+        p.normal_impulse = cp.normal_impulse;
+        p.position_impulse = 0.0;
 
-    const auto get_closest_b_point = [&]( const Edge &e ) -> glm::dvec2
+        // prędkość po odbiciu wyznaczana jest z prędkości przed rozwiązywaniem
+        const double vn = normal_velocity(
+            vel_a, world.w[a], p.rel_a,
+            vel_b, world.w[b], p.rel_b,
+            c.normal );
+
+        p.target_velocity = vn < -restitution_threshold ? -restitution * vn : 0.0;
+
+        p.bias_velocity = position_correction_factor *
+            std::max( cp.depth - linear_slop, 0.0 ) / dt;
+    }
+}
+
+// zapisz prędkości obiektów kontaktu - prędkości nieruszalnych obiektów się
+// nie zmieniają i nie są zapisywane, więc kontakty różnych kolorów
+// mogą z nich korzystać równolegle
+static void store_velocities( World &world, const Simple_PhysicsEngine::ContactConstraint &c,
+    const glm::dvec2 &vel_a, double ang_vel_a, const glm::dvec2 &vel_b, double ang_vel_b )
+{
+    if( c.dynamic_a )
     {
-        return *std::min_element(world_b.begin(), world_b.end(),
-            [&]( const glm::dvec2 &pt1, const glm::dvec2 &pt2 )
-            {
-                return e.signed_distance(pt1) < e.signed_distance(pt2);
-            } );
-    };
+        world.vx[c.a] = vel_a.x; world.vy[c.a] = vel_a.y; world.w[c.a] = ang_vel_a;
+    }
 
-    Edge edge{ world_a.back(), world_a.front() };
-    glm::dvec2 pt = get_closest_b_point( edge );
+    if( c.dynamic_b )
+    {
+        world.vx[c.b] = vel_b.x; world.vy[c.b] = vel_b.y; world.w[c.b] = ang_vel_b;
+    }
+}
 
-    for( size_t i = 0; i < world_a.size() - 1; i++ )
+void Simple_PhysicsEngine::warm_start( World &world, size_t begin, size_t end,
+    StepStats &stats )
+{
+    for( size_t k = begin; k < end; k++ )
     {
-        Edge new_edge{ world_a[i], world_a[i+1] };
-        glm::dvec2 new_pt = get_closest_b_point( new_edge );
+        const ContactConstraint &c = constraints[k];
+
+        glm::dvec2 vel_a = world.get_velocity( c.a ), vel_b = world.get_velocity( c.b );
+        double ang_vel_a = world.w[c.a], ang_vel_b = world.w[c.b];
 
-        if( new_edge.signed_distance(new_pt) >
-            edge.signed_distance(pt) )
+        for( int i = 0; i < c.count; i++ )
         {
-            edge = new_edge;
-            pt = new_pt;   
+            apply_normal_impulse( c,
+                vel_a, ang_vel_a, c.points[i].rel_a,
+                vel_b, ang_vel_b, c.points[i].rel_b,
+                c.points[i].normal_impulse );
+
+            stats.impulses += c.points[i].normal_impulse != 0.0;
         }
-    }
 
-    return {edge, pt};
+        store_velocities( world, c, vel_a, ang_vel_a, vel_b, ang_vel_b );
+    }
 }
 
-// kombinacja metod rzutowania i impulsów
-// https://research.ncl.ac.uk/game/mastersdegree/gametechnologies/physicstutorials/5collisionresponse/Physics%20-%20Collision%20Response.pdf
-void Simple_PhysicsEngine::deintersect_and_handle_collision(
-    PhysicsObject &a, PhysicsObject &b, 
-    const glm::dvec2 &point, const glm::dvec2 &normal,
-    double dist )
+// skumulowany impuls nie może przyciągać obiektów,
+// więc przykładana jest tylko jego zmiana po obcięciu do zera
+void Simple_PhysicsEngine::solve_velocities( World &world, size_t begin, size_t end,
+    StepStats &stats )
 {
-    assert( !(a.flags & PhysicsObject::Immovable) ||
-            !(b.flags & PhysicsObject::Immovable ) );
-    
-    const glm::dvec2 deintersect_vec = dist * normal;
-    const double sum_inv_mass = a.inv_mass + b.inv_mass;
+    for( size_t k = begin; k < end; k++ )
+    {
+        ContactConstraint &c = constraints[k];
+
+        glm::dvec2 vel_a = world.get_velocity( c.a ), vel_b = world.get_velocity( c.b );
+        double ang_vel_a = world.w[c.a], ang_vel_b = world.w[c.b];
+
+        for( int i = 0; i < c.count; i++ )
+        {
+            ContactConstraint::Point &p = c.points[i];
 
-    a.move_by(-deintersect_vec * (a.inv_mass / sum_inv_mass), 0 );
-    b.move_by( deintersect_vec * (b.inv_mass / sum_inv_mass), 0 );
+            const double vn = normal_velocity(
+                vel_a, ang_vel_a, p.rel_a,
+                vel_b, ang_vel_b, p.rel_b,
+                c.normal );
 
-    const glm::dvec2 rel_a = point - a.center;
-    const glm::dvec2 rel_b = point - b.center;
+            const double lambda = ( p.target_velocity - vn ) * p.normal_mass;
+            const double accumulated = std::max( p.normal_impulse + lambda, 0.0 );
+            const double impulse = accumulated - p.normal_impulse;
+            p.normal_impulse = accumulated;
 
-    const glm::dvec2 ang_vel_a = a.ang_velocity * rot90( rel_a );
-    const glm::dvec2 ang_vel_b = b.ang_velocity * rot90( rel_b );
+            apply_normal_impulse( c,
+                vel_a, ang_vel_a, p.rel_a,
+                vel_b, ang_vel_b, p.rel_b,
+                impulse );
 
-    const glm::dvec2 full_vel_a = a.velocity + ang_vel_a;
-    const glm::dvec2 full_vel_b = b.velocity + ang_vel_b;
+            stats.impulses += impulse != 0.0;
+        }
 
-    const glm::dvec2 contact_vel = full_vel_b - full_vel_a;
+        store_velocities( world, c, vel_a, ang_vel_a, vel_b, ang_vel_b );
+    }
+}
 
-    double impulseForce = glm::dot( contact_vel, normal );
+// korekcja przenikania na osobnych prędkościach, które nie są zapamiętywane,
+// więc rozsuwanie obiektów nie dodaje im energii - obiekty są tylko
+// przesuwane, obracanie ich przy rozsuwaniu wprowadzało by obroty
+// do leżących na sobie obiektów
+void Simple_PhysicsEngine::solve_positions( size_t begin, size_t end, StepStats &stats )
+{
+    for( size_t k = begin; k < end; k++ )
+    {
+        ContactConstraint &c = constraints[k];
 
-    if( impulseForce < 0 ) // obiekty rozdzielają się samoczynnie
-        return;
+        glm::dvec2 vel_a = position_velocity[c.a], vel_b = position_velocity[c.b];
+        const double mass = 1.0 / ( c.inv_mass_a + c.inv_mass_b );
 
-    const double angular_force_a =
-        vec_cross(rel_a, normal) * a.inv_moment_of_intertia;
-    
-    const glm::dvec2 inertia_a = rot90( angular_force_a * rel_a );
+        for( int i = 0; i < c.count; i++ )
+        {
+            ContactConstraint::Point &p = c.points[i];
 
-    const double angular_force_b =
-        vec_cross(rel_b, normal) * b.inv_moment_of_intertia;
-    
-    const glm::dvec2 inertia_b = rot90( angular_force_b * rel_b );
+            const double vn = glm::dot( vel_b - vel_a, c.normal );
 
-    const double angular_effect = glm::dot( inertia_a + inertia_b, normal );
+            const double lambda = ( p.bias_velocity - vn ) * mass;
+            const double accumulated = std::max( p.position_impulse + lambda, 0.0 );
+            const double impulse = accumulated - p.position_impulse;
+            p.position_impulse = accumulated;
 
-    const glm::dvec2 impulse = 
-        ( -( 1.0 + restitution ) * impulseForce ) /
-        ( sum_inv_mass + angular_effect ) * normal;
+            vel_a -= impulse * c.inv_mass_a * c.normal;
+            vel_b += impulse * c.inv_mass_b * c.normal;
 
-    a.add_impulse( rel_a,-impulse );
-    b.add_impulse( rel_b, impulse );
+            stats.position_corrections += impulse != 0.0;
+        }
+
+        if( c.dynamic_a ) position_velocity[c.a] = vel_a;
+        if( c.dynamic_b ) position_velocity[c.b] = vel_b;
+    }
 }
 
-// rozwiąż kolizję jeżeli taka zaszła
-void Simple_PhysicsEngine::handle_potential_collision( 
-    PhysicsObject &a, 
-    PhysicsObject &b )
+void Simple_PhysicsEngine::color_constraints( size_t body_count )
 {
-    // znajdź najkrótrzy wektor rozdzielający obiekty
-    auto [e_a, p_b] = get_shortest_edge_point_dist(a, b);
-    auto [e_b, p_a] = get_shortest_edge_point_dist(b, a);
-    
-    double d1 = e_a.signed_distance(p_b);
-    double d2 = e_b.signed_distance(p_a);
+    // zachłanne kolorowanie w kolejności kontaktów - kontakt dostaje najmniejszy
+    // kolor nieużyty jeszcze przez żaden z jego ruchomych obiektów
+    body_colors.assign( body_count, 0 );
+    constraint_color.resize( constraints.size() );
+    color_start.assign( max_colors + 2, 0 );
+
+    for( size_t k = 0; k < constraints.size(); k++ )
+    {
+        const ContactConstraint &c = constraints[k];
+
+        uint64_t used = 0;
+        if( c.dynamic_a ) used |= body_colors[c.a];
+        if( c.dynamic_b ) used |= body_colors[c.b];
+
+        // wszystkie kolory zajęte - kontakt trafia do ostatniej grupy,
+        // rozwiązywanej w jednym wątku
+        uint32_t color = max_colors;
+
+        if( ~used )
+        {
+            color = 0;
+            while( used & ( 1ull << color ) )
+                color++;
+
+            if( c.dynamic_a ) body_colors[c.a] |= 1ull << color;
+            if( c.dynamic_b ) body_colors[c.b] |= 1ull << color;
+        }
+
+        constraint_color[k] = color;
+        color_start[color + 1]++;
+    }
 
-    // obiekty nie nachodzą na siebie
-    if( d1 > 0 || d2 > 0 ) return;
+    for( size_t color = 0; color <= max_colors; color++ )
+        color_start[color + 1] += color_start[color];
 
-    if( d1 > d2 )
+    // ułóż kontakty kolorami, zachowując kolejność wewnątrz koloru
+    colored_constraints.resize( constraints.size() );
+    color_fill.assign( color_start.begin(), color_start.end() - 1 );
+
+    for( size_t k = 0; k < constraints.size(); k++ )
+        colored_constraints[ color_fill[constraint_color[k]]++ ] = constraints[k];
+
+    constraints.swap( colored_constraints );
+
+    color_count = 0;
+    for( size_t color = 0; color < max_colors; color++ )
+        if( color_start[color + 1] > color_start[color] )
+            color_count = color + 1;
+}
+
+template<class F>
+void Simple_PhysicsEngine::for_each_color( F &&solve )
+{
+    // kontakty jednego koloru nie mają wspólnych ruchomych obiektów,
+    // więc mogą być rozwiązywane równolegle
+    for( size_t color = 0; color < color_count; color++ )
     {
-        deintersect_and_handle_collision(
-            a, b,
-            p_b, e_a.get_normal(),
-            -d1
-        );
+        const size_t begin = color_start[color], end = color_start[color + 1];
+
+        jobs.parallel_for( end - begin, solver_grain, [&]( const JobRange &range )
+        {
+            solve( begin + range.begin, begin + range.end, thread_stats[range.thread] );
+        } );
     }
-    else
+
+    // kontakty bez koloru
+    if( color_start[max_colors + 1] > color_start[max_colors] )
+        solve( color_start[max_colors], color_start[max_colors + 1], thread_stats[0] );
+}
+
+static std::unique_ptr<IBroadphase> create_broadphase(
+    Simple_PhysicsEngine::BroadphaseType type )
+{
+    switch( type )
     {
-        deintersect_and_handle_collision(
-            a, b,
-            p_a, e_b.get_normal(),
-            d2
-        );
+    case Simple_PhysicsEngine::AABBTree:
+        return std::make_unique<AABBTree_Broadphase>();
+    case Simple_PhysicsEngine::HashGrid:
+        return std::make_unique<HashGrid_Broadphase>();
+    case Simple_PhysicsEngine::SweepAndPrune:
+    default:
+        return std::make_unique<SAP_Broadphase>();
     }
 }
 
-void Simple_PhysicsEngine::onTick( std::vector<PhysicsObject> &objs, double dt )
+void Simple_PhysicsEngine::onTick( World &world, double dt )
 {
+    PROFILE_ZONE( "Simple_PhysicsEngine::onTick" );
+
+    // uruchomienie wątków alokuje pamięć - nie jest liczone do kroku
+    jobs.set_thread_count( thread_count );
+    thread_stats.reset( jobs.get_thread_count() );
+
+    const uint64_t allocations_before = get_allocation_count();
+
+    if( !broadphase || current_broadphase_type != broadphase_type )
+    {
+        broadphase = create_broadphase( broadphase_type );
+        broadphase->set_job_system( &jobs );
+        current_broadphase_type = broadphase_type;
+    }
+
+    pair_counts.clear();
+    step_stats = StepStats{};
+
+    if( !sleeping_enabled )
+        for( uint32_t i = 0; i < world.size(); i++ )
+            if( world.flags[i] & PhysicsObject::Sleeping )
+                world.wake_up( i );
+
     dt /= time_subdivision;
 
     for( int i = 0; i < time_subdivision; i++ )
-        onTick_subdivided( objs, dt );
+    {
+        thread_stats.reset( jobs.get_thread_count() );
+        const uint64_t substep_allocations = get_allocation_count();
+
+        onTick_subdivided( world, dt );
+
+        StepStats substep = thread_stats.merged();
+        substep.substeps = 1;
+        substep.allocations = get_allocation_count() - substep_allocations;
+        step_stats += substep;
+    }
+
+    tick_allocations = get_allocation_count() - allocations_before;
 }
 
-void Simple_PhysicsEngine::onTick_subdivided( std::vector<PhysicsObject> &objs, double dt )
+EngineStatus Simple_PhysicsEngine::get_status() const
 {
-    // dodaj siłę grawitacji
-    for( PhysicsObject &obj : objs )
-        if( !( obj.flags & PhysicsObject::Immovable ) )
-            obj.add_impulse( {0, 0}, { 0.0, -gravity * dt / obj.inv_mass } );
+    EngineStatus status;
+    status.sleeping_count = sleeping_count;
+    status.color_count = color_count;
+    status.tick_allocations = tick_allocations;
+    status.stats = step_stats;
 
-    // zmniejsz prędkości obiektów
-    const double dump_vel_factor = pow( 1. - dump_velocity_factor, dt );
-    const double dump_ang_vel_factor = pow( 1. - dump_angular_velocity_factor, dt );
+    if( !pair_counts.empty() )
+    {
+        status.min_pairs = *std::min_element( pair_counts.begin(), pair_counts.end() );
+        status.max_pairs = *std::max_element( pair_counts.begin(), pair_counts.end() );
+    }
+
+    return status;
+}
+
+void Simple_PhysicsEngine::integrate( World &world, double dt )
+{
+    PROFILE_ZONE( "integrate" );
+
+    IntegrationState state;
+    state.x = world.x.data();
+    state.y = world.y.data();
+    state.angle = world.angle.data();
+    state.vx = world.vx.data();
+    state.vy = world.vy.data();
+    state.w = world.w.data();
+    state.flags = world.flags.data();
+    state.count = world.size();
+
+    IntegrationParams params;
+    params.gravity_dv = -gravity * dt;
+    params.velocity_factor = pow( 1. - dump_velocity_factor, dt );
+    params.angular_velocity_factor = pow( 1. - dump_angular_velocity_factor, dt );
+    params.dt = dt;
+    // nieruszalne i uśpione obiekty stoją w miejscu
+    params.skip_flags = inactive_flags;
+
+    // każdy fragment całkuje własny przedział tablic
+    jobs.parallel_for( world.size(), integration_grain, [&]( const JobRange &range )
+    {
+        IntegrationState part = state;
+        part.x += range.begin;
+        part.y += range.begin;
+        part.angle += range.begin;
+        part.vx += range.begin;
+        part.vy += range.begin;
+        part.w += range.begin;
+        part.flags += range.begin;
+        part.count = range.end - range.begin;
+
+        integrate_bodies( part, params, simd_level );
+
+        uint64_t integrated = 0;
+        for( size_t i = range.begin; i < range.end; i++ )
+            integrated += !( world.flags[i] & params.skip_flags );
+        thread_stats[range.thread].bodies_integrated += integrated;
+    } );
+}
+
+void Simple_PhysicsEngine::onTick_subdivided( World &world, double dt )
+{
+    PROFILE_ZONE( "onTick_subdivided" );
+
+    integrate( world, dt );
 
-    for( PhysicsObject &obj : objs )
+    // znajdź pary które mogą kolidować, obliczenie AABB oblicza też
+    // obrócone punkty z których korzysta wąska faza
     {
-        obj.velocity *= dump_vel_factor;
-        obj.ang_velocity *= dump_ang_vel_factor;
+        PROFILE_ZONE( "update_aabbs" );
+
+        aabbs.resize( world.size() );
+        jobs.parallel_for( world.size(), aabb_grain, [&]( const JobRange &range )
+        {
+            for( size_t i = range.begin; i < range.end; i++ )
+                aabbs[i] = world.get_aabb( (uint32_t)i );
+        } );
+    }
+
+    {
+        PROFILE_ZONE( "broadphase" );
+        broadphase->find_pairs( aabbs, pairs );
+    }
+
+    thread_stats[0].aabb_tests += broadphase->get_aabb_tests();
+    thread_stats[0].candidate_pairs += pairs.size();
+
+    pair_counts.push_back( pairs.size() );
+
+    // zbiór obiektów zmienił się (np. wczytano scenę) - zapomnij stan par
+    if( cached_revision != world.get_revision() )
+    {
+        contact_cache.clear();
+        cached_revision = world.get_revision();
+    }
+
+    contact_cache.begin_frame( pairs.size() );
+
+    // przydziel pary w pamięci par - dodawanych jest najwyżej pairs.size() par,
+    // więc wskaźniki pozostają ważne do końca kroku
+    pair_contacts.resize( pairs.size() );
+    pair_colliding.resize( pairs.size() );
+
+    for( size_t k = 0; k < pairs.size(); k++ )
+    {
+        const auto [i, j] = pairs[k];
+        pair_contacts[k] = nullptr;
+
+        if( is_potentially_colliding( aabbs[i], aabbs[j], world.flags[i], world.flags[j] ) )
+            pair_contacts[k] = &contact_cache.get( i, j );
+        else if( (world.flags[i] & PhysicsObject::Sleeping) ||
+                 (world.flags[j] & PhysicsObject::Sleeping) )
+        {
+            // zachowaj kontakty uśpionych obiektów do ciepłego startu po obudzeniu
+            contact_cache.get( i, j );
+        }
+    }
+
+    // znajdź kontakty równolegle (obiekty nie są przesuwane aż do końca kroku,
+    // każda para zapisuje tylko swoje dane)
+    {
+        PROFILE_ZONE( "narrowphase" );
+
+        jobs.parallel_for( pairs.size(), narrowphase_grain, [&]( const JobRange &range )
+        {
+            StepStats &stats = thread_stats[range.thread];
+
+            for( size_t k = range.begin; k < range.end; k++ )
+            {
+                const auto [i, j] = pairs[k];
+
+                pair_colliding[k] = pair_contacts[k] && find_contact(
+                    world.get_polygon( i ), world.get_polygon( j ), *pair_contacts[k] );
+
+                stats.narrowphase_calls += pair_contacts[k] != nullptr;
+                stats.contacts += pair_colliding[k];
+            }
+        } );
+    }
+
+    // dodaj kontakty w kolejności par, niezależnie od liczby wątków
+    constraints.clear();
+    woken_bodies.clear();
+
+    for( size_t k = 0; k < pairs.size(); k++ )
+    {
+        if( !pair_colliding[k] ) continue;
+
+        const auto [i, j] = pairs[k];
+
+        // kontakt z obudzonym obiektem budzi uśpiony obiekt
+        for( uint32_t body : { i, j } )
+            if( world.flags[body] & PhysicsObject::Sleeping )
+            {
+                world.wake_up( body );
+                woken_bodies.push_back( body );
+            }
+
+        add_constraint( world, i, j, pair_contacts[k]->manifold, dt );
+    }
+
+    // ... a razem z nim resztę jego wyspy
+    if( !woken_bodies.empty() )
+        wake_islands( world );
+
+    // podziel kontakty na kolory do równoległego rozwiązywania, kolejność
+    // rozwiązywania zależy tylko od kontaktów, nie od liczby wątków
+    {
+        PROFILE_ZONE( "color_constraints" );
+        color_constraints( world.size() );
+    }
+
+    // rozwiąż prędkości
+    {
+        PROFILE_ZONE( "solve_velocities" );
+
+        for_each_color( [&]( size_t begin, size_t end, StepStats &stats )
+        {
+            warm_start( world, begin, end, stats );
+        } );
+
+        for( int i = 0; i < velocity_iterations; i++ )
+            for_each_color( [&]( size_t begin, size_t end, StepStats &stats )
+            {
+                solve_velocities( world, begin, end, stats );
+            } );
+    }
+
+    // zapamiętaj skumulowane impulsy do ciepłego startu w następnym kroku
+    for( const ContactConstraint &c : constraints )
+    {
+        Manifold &manifold = contact_cache.get( c.a, c.b ).manifold;
+
+        for( int i = 0; i < c.count; i++ )
+            manifold.points[i].normal_impulse = c.points[i].normal_impulse;
     }
 
-    // przemieść obiekty zgodnie z ich prędkościami
-    for( PhysicsObject &obj : objs )
-        obj.time_step( dt );
+    // usuń przenikanie
+    {
+        PROFILE_ZONE( "solve_positions" );
+
+        position_velocity.assign( world.size(), glm::dvec2( 0.0 ) );
+
+        for( int i = 0; i < position_iterations; i++ )
+            for_each_color( [&]( size_t begin, size_t end, StepStats &stats )
+            {
+                solve_positions( begin, end, stats );
+            } );
+
+        for( uint32_t i = 0; i < world.size(); i++ )
+        {
+            world.x[i] += position_velocity[i].x * dt;
+            world.y[i] += position_velocity[i].y * dt;
+        }
+    }
+
+    if( sleeping_enabled )
+        update_sleeping( world, dt );
+}
+
+uint32_t Simple_PhysicsEngine::find_island( uint32_t body )
+{
+    // skracanie ścieżki o połowę
+    while( island_parent[body] != body )
+    {
+        island_parent[body] = island_parent[island_parent[body]];
+        body = island_parent[body];
+    }
+
+    return body;
+}
+
+void Simple_PhysicsEngine::wake_islands( World &world )
+{
+    PROFILE_ZONE( "wake_islands" );
+
+    const uint32_t n = (uint32_t)world.size();
+
+    // uśpione obiekty nie mają kontaktów, więc ich wyspy są odtwarzane z par
+    // szerokiej fazy - spoczywające na sobie obiekty mają przecinające się AABB
+    // (sąsiednie wyspy też mogą zostać połączone, wtedy budzą się obie)
+    island_woken.assign( n, 0 );
+    for( uint32_t body : woken_bodies )
+        island_woken[body] = 1;
+
+    auto was_sleeping = [&]( uint32_t body )
+    {
+        return ( world.flags[body] & PhysicsObject::Sleeping ) || island_woken[body];
+    };
+
+    island_parent.resize( n );
+    std::iota( island_parent.begin(), island_parent.end(), 0 );
 
-    // znajdź kolizje i je rozwiąrz
-    for( PhysicsObject &obj : objs )
-        for( PhysicsObject &obj2 : objs )
-            if( &obj != &obj2 && is_potentially_colliding( obj, obj2 ) )
-                handle_potential_collision( obj, obj2 );
-}
\ No newline at end of file
+    for( const auto &[i, j] : pairs )
+        if( was_sleeping( i ) && was_sleeping( j ) &&
+            !( world.flags[i] & PhysicsObject::Immovable ) &&
+            !( world.flags[j] & PhysicsObject::Immovable ) )
+            island_parent[find_island( i )] = find_island( j );
+
+    // zaznacz korzenie obudzonych wysp i obudź pozostałe obiekty tych wysp
+    for( uint32_t body : woken_bodies )
+        island_woken[find_island( body )] = 2;
+
+    for( uint32_t i = 0; i < n; i++ )
+        if( ( world.flags[i] & PhysicsObject::Sleeping ) &&
+            island_woken[find_island( i )] == 2 )
+            world.wake_up( i );
+}
+
+void Simple_PhysicsEngine::update_sleeping( World &world, double dt )
+{
+    PROFILE_ZONE( "update_sleeping" );
+
+    const double linear_tolerance_sq = sleep_linear_velocity * sleep_linear_velocity;
+    const uint32_t n = (uint32_t)world.size();
+
+    for( uint32_t i = 0; i < n; i++ )
+    {
+        if( world.flags[i] & inactive_flags ) continue;
+
+        const glm::dvec2 vel = world.get_velocity( i );
+
+        if( glm::dot( vel, vel ) > linear_tolerance_sq ||
+            std::abs( world.w[i] ) > sleep_angular_velocity )
+            world.sleep_time[i] = 0.0;
+        else
+            world.sleep_time[i] += dt;
+    }
+
+    // wyspy - obiekty połączone kontaktami, nieruszalne obiekty ich nie łączą
+    island_parent.resize( n );
+    std::iota( island_parent.begin(), island_parent.end(), 0 );
+
+    for( const ContactConstraint &c : constraints )
+        if( !( world.flags[c.a] & PhysicsObject::Immovable ) &&
+            !( world.flags[c.b] & PhysicsObject::Immovable ) )
+            island_parent[find_island( c.a )] = find_island( c.b );
+
+    // wyspa może zasnąć gdy wszystkie jej obiekty spoczywają wystarczająco długo
+    island_sleep_time.assign( n, std::numeric_limits<double>::infinity() );
+
+    for( uint32_t i = 0; i < n; i++ )
+        if( !( world.flags[i] & inactive_flags ) )
+        {
+            double &time = island_sleep_time[find_island( i )];
+            time = std::min( time, world.sleep_time[i] );
+        }
+
+    sleeping_count = 0;
+
+    for( uint32_t i = 0; i < n; i++ )
+    {
+        if( !( world.flags[i] & inactive_flags ) &&
+            island_sleep_time[find_island( i )] >= time_to_sleep )
+        {
+            world.flags[i] |= PhysicsObject::Sleeping;
+            world.vx[i] = 0.0;
+            world.vy[i] = 0.0;
+            world.w[i] = 0.0;
+        }
+
+        if( world.flags[i] & PhysicsObject::Sleeping )
+            sleeping_count++;
+    }
+}
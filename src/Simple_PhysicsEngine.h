@@ -8,16 +8,25 @@ nagłówek silnika fizyki
 
 #include "interfaces.h"
 #include "PhysicsObject.h"
+#include "World.h"
+#include "Broadphase.h"
+#include "Narrowphase.h"
+#include "PairCache.h"
+#include "CpuFeatures.h"
+#include "JobSystem.h"
+#include "StepStats.h"
 
 #include <vector>
+#include <memory>
+#include <stdint.h>
 
 /**
- * @brief silnik fizyki oparty na metodzie rzutów i impulsów
+ * @brief parametry Simple_PhysicsEngine
+ * 
+ * wydzielone do osobnej struktury, by można je było skopiować
+ * i przekazać do silnika działającego w innym wątku
  */
-class Simple_PhysicsEngine : public IPhysicsEngine {
-public:
-    virtual void onTick( std::vector<PhysicsObject> &objs, double dt );
-
+struct Simple_PhysicsEngineParameters {
     double gravity = 9.81; ///< siła grawitacji [m/s2]
     double dump_velocity_factor = 0.05; ///< część prędkości jaką obiekty wytracają w 1s
 
@@ -34,19 +43,226 @@ public:
      */
     int time_subdivision = 2;
 
+    int velocity_iterations = 8; ///< liczba iteracji rozwiązywania prędkości kontaktów
+    int position_iterations = 3; ///< liczba iteracji usuwania przenikania obiektów
+
+    /**
+     * @brief dostępne algorytmy szerokiej fazy wykrywania kolizji
+     */
+    enum BroadphaseType {
+        SweepAndPrune, ///< sortowanie i zamiatanie (SAP_Broadphase)
+        AABBTree, ///< dynamiczne drzewo AABB (AABBTree_Broadphase)
+        HashGrid ///< haszowana siatka (HashGrid_Broadphase)
+    };
+
+    /**
+     * @brief używany algorytm szerokiej fazy
+     * 
+     * zmiana zaczyna obowiązywać od następnego kroku symulacji
+     */
+    BroadphaseType broadphase_type = SweepAndPrune;
+
+    /**
+     * @brief dostępne algorytmy wąskiej fazy wykrywania kolizji
+     */
+    enum NarrowphaseType {
+        EdgePoint, ///< każda krawędź z każdym punktem (collide_edge_point)
+        SAT, ///< twierdzenie o osi rozdzielającej (collide_sat)
+        GJK_EPA ///< algorytmy GJK i EPA (collide_gjk_epa)
+    };
+
+    NarrowphaseType narrowphase_type = SAT; ///< używany algorytm wąskiej fazy
+
+    /**
+     * @brief liczba wątków wykonujących krok symulacji (razem z wywołującym onTick)
+     * 
+     * całkowanie, obliczanie AABB, szeroka i wąska faza są wykonywane równolegle,
+     * wynik kroku nie zależy od liczby wątków. 0 oznacza liczbę wątków sprzętowych
+     */
+    unsigned thread_count = JobSystem::get_hardware_threads();
+
+    /**
+     * @brief zestaw instrukcji używany przez jądro całkowania
+     * 
+     * domyślnie najlepszy obsługiwany przez procesor, nie może być lepszy
+     */
+    SimdLevel simd_level = get_simd_level();
+
+    /**
+     * @brief czy rozwiązywanie kontaktu zaczyna od impulsów z poprzedniego kroku
+     */
+    bool warm_starting = true;
+
+    /**
+     * @brief czy spoczywające wyspy obiektów są usypiane
+     * 
+     * wyspa to obiekty połączone kontaktami, zasypia gdy prędkości wszystkich
+     * jej obiektów są poniżej progów przez time_to_sleep sekund
+     */
+    bool sleeping_enabled = true;
+
+    double sleep_linear_velocity = 0.05; ///< próg prędkości do uśpienia [m/s]
+    double sleep_angular_velocity = 0.05; ///< próg prędkości kątowej do uśpienia [rad/s]
+    double time_to_sleep = 0.5; ///< czas spoczynku po którym wyspa zasypia [s]
+};
+
+/**
+ * @brief silnik fizyki oparty na metodzie sekwencyjnych impulsów
+ * 
+ * w każdym podkroku zbiera wszystkie kontakty, a następnie rozwiązuje
+ * prędkości w velocity_iterations iteracjach i usuwa przenikanie
+ * w position_iterations iteracjach
+ * 
+ * kontakty są dzielone na kolory tak, by kontakty jednego koloru nie miały
+ * wspólnych ruchomych obiektów - kolory są rozwiązywane po kolei,
+ * a kontakty wewnątrz koloru równolegle
+ */
+class Simple_PhysicsEngine : public IPhysicsEngine, public Simple_PhysicsEngineParameters {
+public:
+    virtual void onTick( World &world, double dt );
+
+    virtual EngineStatus get_status() const;
+
+    /**
+     * @brief zwraca liczbę uśpionych obiektów po ostatnim kroku symulacji
+     */
+    size_t get_sleeping_count() const { return sleeping_count; }
+
+    /**
+     * @brief zwraca liczby par znalezionych przez szeroką fazę
+     *        w kolejnych podkrokach ostatniego kroku symulacji
+     */
+    const std::vector<size_t> &get_pair_counts() const { return pair_counts; }
+
+    /**
+     * @brief zwraca liczbę kolorów kontaktów w ostatnim podkroku
+     * 
+     * kontakty jednego koloru nie mają wspólnych ruchomych obiektów
+     * i są rozwiązywane równolegle
+     */
+    size_t get_color_count() const { return color_count; }
+
+    /**
+     * @brief zwraca liczbę alokacji pamięci wykonanych w ostatnim kroku symulacji
+     * 
+     * w stanie ustalonym (bez dodawania obiektów) powinna wynosić 0
+     */
+    uint64_t get_tick_allocations() const { return tick_allocations; }
+
+    /**
+     * @brief zwraca liczniki pracy wykonanej w ostatnim kroku symulacji
+     */
+    const StepStats &get_step_stats() const { return step_stats; }
+
+    /**
+     * @brief czy para z szerokiej fazy trafia do wąskiej fazy - dwa nieruszalne
+     *        lub uśpione obiekty nie kolidują, pozostałe gdy przecinają się ich AABB
+     * 
+     * @param flags_a, flags_b opcje obiektów (zobacz PhysicsObject::FlagBits)
+     */
+    static bool is_potentially_colliding( const AABB &a, const AABB &b,
+        uint32_t flags_a, uint32_t flags_b )
+    {
+        const uint32_t inactive = PhysicsObject::Immovable | PhysicsObject::Sleeping;
+
+        if( (flags_a & inactive) && (flags_b & inactive) )
+            return false;
+
+        return a.overlaps( b );
+    }
+
+    /**
+     * @brief kontakt przygotowany do rozwiązywania
+     */
+    struct ContactConstraint {
+        uint32_t a, b; ///< indeksy obiektów
+        glm::dvec2 normal; ///< normalna kontaktu, skierowana od a do b
+        int count; ///< liczba punktów kontaktu
+
+        double inv_mass_a, inv_mass_b; ///< odwrotności mas obiektów [1/kg]
+        double inv_moment_of_intertia_a, inv_moment_of_intertia_b; ///< [1/(kg*m2)]
+        bool dynamic_a, dynamic_b; ///< czy prędkości obiektów są zmieniane (nie są nieruszalne)
+
+        struct Point {
+            glm::dvec2 rel_a, rel_b; ///< punkt kontaktu względem środków obiektów [m]
+            double normal_mass; ///< masa efektywna wzdłuż normalnej [kg]
+            double target_velocity; ///< prędkość rozdzielania po odbiciu [m/s]
+            double bias_velocity; ///< prędkość usuwania przenikania [m/s]
+            double normal_impulse; ///< skumulowany impuls normalny [kg*m/s]
+            double position_impulse; ///< skumulowany impuls usuwania przenikania [kg*m/s]
+        } points[2];
+    };
+
 private:
-    void onTick_subdivided( std::vector<PhysicsObject> &objs, double dt );
+    void onTick_subdivided( World &world, double dt );
 
-    bool is_potentially_colliding( const PhysicsObject &a, const PhysicsObject &b );
-    void handle_potential_collision( PhysicsObject &a, PhysicsObject &b );
+    // grawitacja, tłumienie i całkowanie położeń w jednym przejściu (integrate_bodies)
+    void integrate( World &world, double dt );
 
-    // get shortest distance from a's edges to b's points
-    std::pair<Edge,glm::dvec2> get_shortest_edge_point_dist( 
-        const PhysicsObject &a,
-        const PhysicsObject &b );
-    
-    void deintersect_and_handle_collision(
-        PhysicsObject &a, PhysicsObject &b, 
-        const glm::dvec2 &point, const glm::dvec2 &normal,
-        double dist );
+    JobSystem jobs; ///< pula wątków kroku symulacji
+
+    std::unique_ptr<IBroadphase> broadphase;
+    BroadphaseType current_broadphase_type;
+    std::vector<AABB> aabbs; ///< AABB obiektów na początku fazy kolizji
+    std::vector<BodyPair> pairs; ///< pary znalezione przez szeroką fazę
+    std::vector<size_t> pair_counts; ///< liczby par w kolejnych podkrokach
+    uint64_t tick_allocations = 0; ///< liczba alokacji w ostatnim kroku
+
+    StepStats step_stats; ///< liczniki ostatniego kroku
+    PerThread<StepStats> thread_stats; ///< liczniki obecnego podkroku w każdym wątku
+
+    /**
+     * @brief stan pary obiektów pamiętany pomiędzy krokami
+     */
+    struct PairContact {
+        SATCache sat; ///< ostatnia oś rozdzielająca
+        Manifold manifold; ///< ostatni kontakt wraz ze skumulowanymi impulsami
+    };
+
+    PairCache<PairContact> contact_cache; ///< stan par kandydatów z szerokiej fazy
+    uint64_t cached_revision = UINT64_MAX; ///< numer zmiany świata dla którego zapamiętano pary
+
+    std::vector<PairContact*> pair_contacts; ///< stan par do wąskiej fazy lub nullptr
+    std::vector<uint8_t> pair_colliding; ///< czy wąska faza znalazła kontakt pary
+
+    std::vector<ContactConstraint> constraints; ///< kontakty w obecnym podkroku
+    std::vector<glm::dvec2> position_velocity; ///< prędkości usuwania przenikania
+
+    /**
+     * @brief liczba kolorów kontaktów, kontakty które się nie zmieściły
+     *        są rozwiązywane w jednym wątku
+     */
+    static constexpr size_t max_colors = 64;
+
+    std::vector<uint64_t> body_colors; ///< maska kolorów kontaktów każdego obiektu
+    std::vector<uint32_t> constraint_color; ///< kolor każdego kontaktu
+    std::vector<size_t> color_start; ///< początki kolorów w constraints (max_colors + 2 wpisów)
+    std::vector<size_t> color_fill; ///< bufor do układania kontaktów kolorami
+    std::vector<ContactConstraint> colored_constraints; ///< bufor do układania kontaktów
+    size_t color_count = 0; ///< liczba użytych kolorów (bez ostatniej grupy)
+
+    std::vector<uint32_t> island_parent; ///< las zbiorów rozłącznych wysp
+    std::vector<double> island_sleep_time; ///< najkrótszy czas spoczynku w wyspie
+    std::vector<uint32_t> woken_bodies; ///< obiekty obudzone kontaktem w obecnym podkroku
+    std::vector<uint8_t> island_woken; ///< 1 - obiekt obudzony kontaktem, 2 - korzeń budzonej wyspy
+    size_t sleeping_count = 0; ///< liczba uśpionych obiektów
+
+    bool find_contact( const Polygon &a, const Polygon &b,
+        PairContact &contact );
+
+    void add_constraint( const World &world,
+        uint32_t a, uint32_t b, const Manifold &manifold, double dt );
+    // rozwiązują kontakty [begin, end) tablicy constraints, zliczając impulsy w stats
+    void warm_start( World &world, size_t begin, size_t end, StepStats &stats );
+    void solve_velocities( World &world, size_t begin, size_t end, StepStats &stats );
+    void solve_positions( size_t begin, size_t end, StepStats &stats );
+
+    void color_constraints( size_t body_count );
+    // wywołuje solve( begin, end, StepStats &stats ) dla kontaktów kolejnych kolorów
+    template<class F> void for_each_color( F &&solve );
+
+    uint32_t find_island( uint32_t body );
+    // budzi wyspy obiektów z woken_bodies
+    void wake_islands( World &world );
+    void update_sleeping( World &world, double dt );
 };
\ No newline at end of file
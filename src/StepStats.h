@@ -0,0 +1,42 @@
+/*
+Jakub Janeczko
+nagłówek liczników kroku symulacji
+18.10.2026
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief liczniki pracy wykonanej w kroku symulacji
+ * 
+ * Simple_PhysicsEngine zlicza je osobno w każdym wątku (PerThread)
+ * i sumuje po każdym podkroku, wartości dotyczą całego kroku (onTick),
+ * czyli substeps podkroków
+ */
+struct StepStats {
+    uint64_t substeps = 0; ///< liczba podkroków
+    uint64_t bodies_integrated = 0; ///< obiekty których ruch został scałkowany
+    uint64_t aabb_tests = 0; ///< testy przecięcia AABB w szerokiej fazie
+    uint64_t candidate_pairs = 0; ///< pary znalezione przez szeroką fazę
+    uint64_t narrowphase_calls = 0; ///< pary sprawdzone przez wąską fazę
+    uint64_t contacts = 0; ///< pary w kontakcie
+    uint64_t impulses = 0; ///< niezerowe impulsy przyłożone w punktach kontaktu
+    uint64_t position_corrections = 0; ///< niezerowe przesunięcia usuwające przenikanie
+    uint64_t allocations = 0; ///< alokacje pamięci
+
+    StepStats &operator+=( const StepStats &o )
+    {
+        substeps += o.substeps;
+        bodies_integrated += o.bodies_integrated;
+        aabb_tests += o.aabb_tests;
+        candidate_pairs += o.candidate_pairs;
+        narrowphase_calls += o.narrowphase_calls;
+        contacts += o.contacts;
+        impulses += o.impulses;
+        position_corrections += o.position_corrections;
+        allocations += o.allocations;
+        return *this;
+    }
+};
@@ -0,0 +1,121 @@
+/*
+Jakub Janeczko
+nagłówek formatu pliku trajektorii
+18.10.2026
+*/
+
+#pragma once
+
+#include <vector>
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+
+/**
+ * @brief plik trajektorii - położenia i prędkości wszystkich obiektów
+ *        w kolejnych krokach symulacji
+ *
+ * plik zaczyna się nagłówkiem TrajectoryFileHeader, po którym następują
+ * kawałki (TrajectoryChunkHeader i dane) dopisywane na koniec pliku:
+ * - klatka kluczowa - dokładne wartości double wszystkich obiektów,
+ *   zapisane kolumnami (x, y, angle, vx, vy, w),
+ * - klatka różnicowa - dla każdego obiektu 6 różnic skwantowanych wartości
+ *   względem poprzedniej klatki, zapisanych jako liczby zmiennej długości
+ *   (zigzag + LEB128), spoczywający obiekt zajmuje 6 bajtów,
+ * - indeks - pary ( krok, położenie w pliku ) wszystkich klatek kluczowych,
+ *   zapisywany przy zamykaniu pliku razem z końcówką TrajectoryFileTrailer
+ *
+ * wartości klatki różnicowej to q * step, gdzie q jest sumą różnic od
+ * ostatniej klatki kluczowej (w której q = rint( wartość / step )), więc
+ * błąd nie kumuluje się i wynosi najwyżej step / 2
+ *
+ * plik bez indeksu (np. przerwany zapis) można odczytać przeglądając kawałki
+ */
+
+constexpr char trajectory_file_magic[8] = { 'P', 'H', 'Y', 'S', '2', 'D', 'T', 'R' };
+constexpr char trajectory_index_magic[8] = { 'P', 'H', 'Y', 'S', '2', 'D', 'I', 'X' };
+constexpr uint32_t trajectory_file_version = 1; ///< zmieniana przy każdej zmianie układu pliku
+constexpr uint32_t trajectory_byte_order = 0x01020304; ///< zapisane w kolejności bajtów pliku
+
+constexpr int trajectory_channel_count = 6; ///< x, y, angle, vx, vy, w
+
+/**
+ * @brief nagłówek pliku trajektorii
+ */
+struct TrajectoryFileHeader {
+    char magic[8]; ///< trajectory_file_magic
+    uint32_t version; ///< trajectory_file_version
+    uint32_t byte_order; ///< trajectory_byte_order
+    uint32_t keyframe_interval; ///< co ile kroków zapisywana jest klatka kluczowa
+    uint32_t reserved;
+
+    /**
+     * @brief kroki kwantyzacji kolejnych wartości w klatkach różnicowych
+     *        (x, y [m], angle [rad], vx, vy [m/s], w [rad/s])
+     */
+    double step[trajectory_channel_count];
+};
+
+/**
+ * @brief rodzaje kawałków pliku trajektorii
+ */
+enum TrajectoryChunkType : uint32_t {
+    TrajectoryKeyframe = 1,
+    TrajectoryDelta = 2,
+    TrajectoryIndex = 3
+};
+
+/**
+ * @brief nagłówek kawałka pliku trajektorii
+ */
+struct TrajectoryChunkHeader {
+    uint32_t type; ///< TrajectoryChunkType
+    uint32_t body_count; ///< liczba obiektów w klatce
+    uint64_t tick; ///< numer kroku klatki, w indeksie ostatni zapisany krok
+    uint64_t size; ///< rozmiar danych po nagłówku [B]
+};
+
+/**
+ * @brief wpis indeksu klatek kluczowych
+ */
+struct TrajectoryIndexEntry {
+    uint64_t tick; ///< numer kroku klatki kluczowej
+    uint64_t offset; ///< położenie nagłówka klatki od początku pliku [B]
+};
+
+/**
+ * @brief końcówka pliku zamkniętego poprawnie
+ */
+struct TrajectoryFileTrailer {
+    uint64_t index_offset; ///< położenie kawałka indeksu od początku pliku [B]
+    char magic[8]; ///< trajectory_index_magic
+};
+
+/**
+ * @brief stan obiektów w jednym kroku odczytany z pliku trajektorii
+ */
+struct TrajectoryFrame {
+    uint64_t tick = 0; ///< numer kroku
+    std::vector<double> channels[trajectory_channel_count]; ///< x, y, angle, vx, vy, w
+
+    size_t size() const { return channels[0].size(); }
+};
+
+/**
+ * @brief kwantuje wartość, false gdy nie mieści się w zakresie klatek różnicowych
+ *
+ * @param inv_step odwrotność kroku kwantyzacji - obliczana raz przez wywołującego,
+ *        by w pętli po obiektach było mnożenie zamiast dzielenia
+ */
+inline bool trajectory_quantize( double value, double inv_step, int64_t &q )
+{
+    const double scaled = value * inv_step;
+
+    // również odrzuca NaN
+    if( !( fabs( scaled ) < 1e15 ) )
+        return false;
+
+    // llrint zaokrągla w obecnym trybie (domyślnie do najbliższej) jedną instrukcją
+    q = (int64_t)llrint( scaled );
+    return true;
+}
@@ -0,0 +1,300 @@
+/*
+Jakub Janeczko
+odczyt trajektorii obiektów
+18.10.2026
+*/
+
+#include "TrajectoryReader.h"
+
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <string.h>
+#include <stdio.h>
+
+namespace {
+
+// fseek z 64-bitowym położeniem
+bool seek_file( FILE *file, uint64_t offset, int origin = SEEK_SET )
+{
+#if defined(_MSC_VER)
+    return _fseeki64( file, (int64_t)offset, origin ) == 0;
+#else
+    return fseeko( file, (off_t)offset, origin ) == 0;
+#endif
+}
+
+uint64_t tell_file( FILE *file )
+{
+#if defined(_MSC_VER)
+    return (uint64_t)_ftelli64( file );
+#else
+    return (uint64_t)ftello( file );
+#endif
+}
+
+bool read_at( FILE *file, uint64_t offset, void *data, size_t size )
+{
+    return seek_file( file, offset ) && fread( data, 1, size, file ) == size;
+}
+
+// odczytuje liczbę zapisaną jako zigzag + LEB128, false gdy dane się skończyły
+bool read_varint( const uint8_t *&p, const uint8_t *end, int64_t &value )
+{
+    uint64_t u = 0;
+
+    for( int shift = 0; shift < 64; shift += 7 )
+    {
+        if( p == end )
+            return false;
+
+        const uint8_t byte = *p++;
+        u |= (uint64_t)( byte & 0x7f ) << shift;
+
+        if( !( byte & 0x80 ) )
+        {
+            value = (int64_t)( u >> 1 ) ^ -(int64_t)( u & 1 );
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace
+
+TrajectoryReader::~TrajectoryReader()
+{
+    if( file )
+        fclose( file );
+}
+
+bool TrajectoryReader::open( const char *path )
+{
+    if( file )
+        fclose( file );
+
+    keyframes.clear();
+    last_tick = 0;
+    frame_valid = false;
+
+    file = fopen( path, "rb" );
+    if( !file )
+        return false;
+
+    if( fread( &header, sizeof(header), 1, file ) != 1 ||
+        memcmp( header.magic, trajectory_file_magic, sizeof(header.magic) ) ||
+        header.version != trajectory_file_version ||
+        header.byte_order != trajectory_byte_order ||
+        !seek_file( file, 0, SEEK_END ) )
+    {
+        fclose( file );
+        file = nullptr;
+        return false;
+    }
+
+    for( int c = 0; c < trajectory_channel_count; c++ )
+    {
+        if( !( header.step[c] > 0.0 ) )
+        {
+            fclose( file );
+            file = nullptr;
+            return false;
+        }
+
+        inv_steps[c] = 1.0 / header.step[c];
+    }
+
+    data_end = tell_file( file );
+
+    if( !read_index() )
+        scan_chunks();
+
+    offset = sizeof(header);
+    return true;
+}
+
+bool TrajectoryReader::read_index()
+{
+    const uint64_t file_size = data_end;
+    const uint64_t min_size = sizeof(TrajectoryFileHeader) +
+        sizeof(TrajectoryChunkHeader) + sizeof(TrajectoryFileTrailer);
+
+    if( file_size < min_size )
+        return false;
+
+    TrajectoryFileTrailer trailer;
+    if( !read_at( file, file_size - sizeof(trailer), &trailer, sizeof(trailer) ) ||
+        memcmp( trailer.magic, trajectory_index_magic, sizeof(trailer.magic) ) ||
+        trailer.index_offset < sizeof(TrajectoryFileHeader) ||
+        trailer.index_offset > file_size - sizeof(trailer) - sizeof(TrajectoryChunkHeader) )
+        return false;
+
+    TrajectoryChunkHeader chunk;
+    const uint64_t index_size = file_size - sizeof(trailer) -
+        sizeof(chunk) - trailer.index_offset;
+
+    if( !read_at( file, trailer.index_offset, &chunk, sizeof(chunk) ) ||
+        chunk.type != TrajectoryIndex || chunk.size != index_size ||
+        chunk.size % sizeof(TrajectoryIndexEntry) )
+        return false;
+
+    keyframes.resize( (size_t)( chunk.size / sizeof(TrajectoryIndexEntry) ) );
+    if( !keyframes.empty() &&
+        fread( keyframes.data(), sizeof(TrajectoryIndexEntry), keyframes.size(), file ) !=
+            keyframes.size() )
+    {
+        keyframes.clear();
+        return false;
+    }
+
+    for( size_t i = 0; i < keyframes.size(); i++ )
+    {
+        if( keyframes[i].offset >= trailer.index_offset ||
+            ( i > 0 && keyframes[i].tick <= keyframes[i - 1].tick ) )
+        {
+            keyframes.clear();
+            return false;
+        }
+    }
+
+    last_tick = chunk.tick;
+    data_end = trailer.index_offset;
+    return true;
+}
+
+void TrajectoryReader::scan_chunks()
+{
+    // dane kończą się na ostatnim całym kawałku
+    offset = sizeof(header);
+    uint64_t end = offset;
+
+    TrajectoryChunkHeader chunk;
+    while( read_chunk_header( chunk ) )
+    {
+        if( chunk.type == TrajectoryKeyframe &&
+            ( keyframes.empty() || chunk.tick > keyframes.back().tick ) )
+            keyframes.push_back( TrajectoryIndexEntry{ chunk.tick, offset } );
+
+        last_tick = chunk.tick;
+        offset += sizeof(chunk) + chunk.size;
+        end = offset;
+    }
+
+    data_end = end;
+}
+
+bool TrajectoryReader::read_chunk_header( TrajectoryChunkHeader &chunk )
+{
+    if( offset > data_end || data_end - offset < sizeof(chunk) ||
+        !read_at( file, offset, &chunk, sizeof(chunk) ) )
+        return false;
+
+    return ( chunk.type == TrajectoryKeyframe || chunk.type == TrajectoryDelta ) &&
+        chunk.size <= data_end - offset - sizeof(chunk);
+}
+
+bool TrajectoryReader::next()
+{
+    TrajectoryChunkHeader chunk;
+    if( !file || !read_chunk_header( chunk ) )
+        return false;
+
+    buffer.resize( (size_t)chunk.size );
+    if( !buffer.empty() && fread( buffer.data(), 1, buffer.size(), file ) != buffer.size() )
+        return false;
+
+    offset += sizeof(chunk) + chunk.size;
+
+    const bool ok = chunk.type == TrajectoryKeyframe ?
+        decode_keyframe( chunk ) : decode_delta( chunk );
+
+    frame_valid = ok;
+    return ok;
+}
+
+bool TrajectoryReader::decode_keyframe( const TrajectoryChunkHeader &chunk )
+{
+    const size_t body_count = chunk.body_count;
+    if( chunk.size != (uint64_t)body_count * trajectory_channel_count * sizeof(double) )
+        return false;
+
+    reference.resize( body_count * trajectory_channel_count );
+
+    for( int c = 0; c < trajectory_channel_count; c++ )
+    {
+        std::vector<double> &channel = frame.channels[c];
+        channel.resize( body_count );
+
+        if( body_count )
+            memcpy( channel.data(), buffer.data() + c * body_count * sizeof(double),
+                body_count * sizeof(double) );
+
+        // tak jak przy zapisie, klatka różnicowa nie następuje po niepowodzeniu
+        for( size_t i = 0; i < body_count; i++ )
+            trajectory_quantize( channel[i], inv_steps[c], reference[c * body_count + i] );
+    }
+
+    frame.tick = chunk.tick;
+    return true;
+}
+
+bool TrajectoryReader::decode_delta( const TrajectoryChunkHeader &chunk )
+{
+    const size_t body_count = chunk.body_count;
+    if( !frame_valid || frame.size() != body_count )
+        return false;
+
+    const uint8_t *p = buffer.data();
+    const uint8_t *end = p + buffer.size();
+
+    for( size_t i = 0; i < body_count; i++ )
+    {
+        for( int c = 0; c < trajectory_channel_count; c++ )
+        {
+            int64_t delta;
+            if( !read_varint( p, end, delta ) )
+                return false;
+
+            int64_t &q = reference[c * body_count + i];
+            q += delta;
+            frame.channels[c][i] = q * header.step[c];
+        }
+    }
+
+    frame.tick = chunk.tick;
+    return p == end;
+}
+
+bool TrajectoryReader::seek( uint64_t tick )
+{
+    if( !file )
+        return false;
+
+    // ostatnia klatka kluczowa nie późniejsza niż tick
+    const auto keyframe = std::upper_bound( keyframes.begin(), keyframes.end(), tick,
+        []( uint64_t t, const TrajectoryIndexEntry &e ) { return t < e.tick; } );
+
+    if( keyframe == keyframes.begin() )
+        return false;
+
+    const TrajectoryIndexEntry &entry = *std::prev( keyframe );
+
+    // bez cofania, jeżeli obecna klatka jest pomiędzy klatką kluczową a tick
+    if( !frame_valid || frame.tick < entry.tick || frame.tick > tick )
+    {
+        offset = entry.offset;
+        frame_valid = false;
+
+        if( !next() )
+            return false;
+    }
+
+    while( frame.tick < tick )
+    {
+        if( !next() )
+            return false;
+    }
+
+    return frame.tick == tick;
+}
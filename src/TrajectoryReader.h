@@ -0,0 +1,90 @@
+/*
+Jakub Janeczko
+nagłówek odczytu trajektorii obiektów
+18.10.2026
+*/
+
+#pragma once
+
+#include "Trajectory.h"
+
+#include <vector>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * @brief odczytuje plik trajektorii zapisany przez TrajectoryRecorder
+ *
+ * seek( tick ) przechodzi do najbliższej wcześniejszej klatki kluczowej
+ * według indeksu i dekoduje kolejne klatki aż do szukanego kroku, więc
+ * koszt nie zależy od długości nagrania. Dla pliku bez indeksu (przerwany
+ * zapis) indeks jest odtwarzany przy otwarciu przez przejrzenie kawałków
+ */
+class TrajectoryReader {
+public:
+    TrajectoryReader() = default;
+    ~TrajectoryReader();
+
+    TrajectoryReader( const TrajectoryReader& ) = delete;
+    TrajectoryReader &operator=( const TrajectoryReader& ) = delete;
+
+    /**
+     * @brief otwiera plik trajektorii i wczytuje indeks klatek kluczowych
+     *
+     * @return false jeżeli pliku nie ma, jest uszkodzony lub ma inną wersję
+     */
+    bool open( const char *path );
+
+    const TrajectoryFileHeader &get_header() const { return header; }
+
+    /**
+     * @brief zwraca klatki kluczowe posortowane po kroku
+     */
+    const std::vector<TrajectoryIndexEntry> &get_keyframes() const { return keyframes; }
+
+    /**
+     * @brief zwraca ostatni zapisany krok
+     */
+    uint64_t get_last_tick() const { return last_tick; }
+
+    /**
+     * @brief dekoduje klatkę kroku tick
+     *
+     * @return false jeżeli kroku nie ma w pliku (np. klatka została pominięta)
+     */
+    bool seek( uint64_t tick );
+
+    /**
+     * @brief dekoduje następną klatkę po ostatnio odczytanej
+     *
+     * @return false na końcu pliku
+     */
+    bool next();
+
+    /**
+     * @brief zwraca ostatnio odczytaną klatkę
+     */
+    const TrajectoryFrame &get_frame() const { return frame; }
+
+private:
+    FILE *file = nullptr;
+    TrajectoryFileHeader header = {};
+    double inv_steps[trajectory_channel_count] = {}; ///< odwrotności kroków kwantyzacji z nagłówka
+    std::vector<TrajectoryIndexEntry> keyframes;
+    uint64_t last_tick = 0;
+    uint64_t data_end = 0; ///< koniec kawałków klatek w pliku [B]
+
+    uint64_t offset = 0; ///< położenie następnego kawałka [B]
+    bool frame_valid = false; ///< czy frame i reference mogą być podstawą klatki różnicowej
+    TrajectoryFrame frame;
+    std::vector<int64_t> reference; ///< skwantowane wartości frame (kanałami)
+    std::vector<uint8_t> buffer; ///< dane kawałka
+
+    bool read_index();
+    void scan_chunks();
+
+    // czyta nagłówek kawałka z offset, false na końcu danych
+    bool read_chunk_header( TrajectoryChunkHeader &chunk );
+    bool decode_keyframe( const TrajectoryChunkHeader &chunk );
+    bool decode_delta( const TrajectoryChunkHeader &chunk );
+};
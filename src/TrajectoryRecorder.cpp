@@ -0,0 +1,298 @@
+/*
+Jakub Janeczko
+zapis trajektorii obiektów
+18.10.2026
+*/
+
+#include "TrajectoryRecorder.h"
+#include "Profiler.h"
+
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <string.h>
+#include <stdio.h>
+
+namespace {
+
+template<class T>
+void append_bytes( std::vector<uint8_t> &out, const T *data, size_t count )
+{
+    const uint8_t *bytes = (const uint8_t*)data;
+    out.insert( out.end(), bytes, bytes + count * sizeof(T) );
+}
+
+constexpr size_t max_varint_size = 10; ///< najdłuższa liczba 64-bitowa w LEB128 [B]
+
+// zapisuje liczbę ze znakiem jako zigzag + LEB128 (1 bajt dla -64..63)
+uint8_t *write_varint( uint8_t *out, int64_t value )
+{
+    uint64_t u = ( (uint64_t)value << 1 ) ^ (uint64_t)( value >> 63 );
+
+    while( u >= 0x80 )
+    {
+        *out++ = (uint8_t)( u | 0x80 );
+        u >>= 7;
+    }
+
+    *out++ = (uint8_t)u;
+    return out;
+}
+
+} // namespace
+
+TrajectoryRecorder::TrajectoryRecorder( const char *path, const TrajectoryOptions &options )
+    : options(options)
+    , steps{ options.position_step, options.position_step, options.angle_step,
+             options.velocity_step, options.velocity_step, options.angular_velocity_step }
+{
+    TrajectoryFileHeader header = {};
+    memcpy( header.magic, trajectory_file_magic, sizeof(header.magic) );
+    header.version = trajectory_file_version;
+    header.byte_order = trajectory_byte_order;
+    header.keyframe_interval = options.keyframe_interval;
+    memcpy( header.step, steps, sizeof(header.step) );
+
+    for( int c = 0; c < trajectory_channel_count; c++ )
+        inv_steps[c] = 1.0 / steps[c];
+
+    file = fopen( path, "wb" );
+    if( !file || fwrite( &header, sizeof(header), 1, file ) != 1 )
+    {
+        if( file )
+            fclose( file );
+
+        file = nullptr;
+        failed.store( true, std::memory_order_relaxed );
+        return;
+    }
+
+    block_offset = sizeof(header);
+    block.reserve( options.block_size );
+
+    // wszystkich bloków jest najwyżej max_pending_blocks + 2
+    pending.reserve( options.max_pending_blocks + 2 );
+    free_blocks.reserve( options.max_pending_blocks + 2 );
+
+    writer = std::thread( &TrajectoryRecorder::writer_loop, this );
+}
+
+TrajectoryRecorder::~TrajectoryRecorder()
+{
+    close();
+}
+
+bool TrajectoryRecorder::close()
+{
+    if( !file )
+        return is_ok();
+
+    submit_block( true );
+
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        closing = true;
+    }
+    pending_ready.notify_one();
+    writer.join();
+
+    // indeks klatek kluczowych i końcówka, plik należy już tylko do tego wątku
+    TrajectoryChunkHeader chunk = {};
+    chunk.type = TrajectoryIndex;
+    chunk.tick = last_tick;
+    chunk.size = index.size() * sizeof(TrajectoryIndexEntry);
+
+    TrajectoryFileTrailer trailer = {};
+    trailer.index_offset = block_offset;
+    memcpy( trailer.magic, trajectory_index_magic, sizeof(trailer.magic) );
+
+    bool ok = fwrite( &chunk, sizeof(chunk), 1, file ) == 1;
+    ok = ok && ( index.empty() ||
+        fwrite( index.data(), sizeof(TrajectoryIndexEntry), index.size(), file ) == index.size() );
+    ok = ok && fwrite( &trailer, sizeof(trailer), 1, file ) == 1;
+
+    if( fclose( file ) != 0 || !ok )
+        failed.store( true, std::memory_order_relaxed );
+
+    file = nullptr;
+    return is_ok();
+}
+
+void TrajectoryRecorder::record( uint64_t tick, const World &world )
+{
+    PROFILE_ZONE( "record_trajectory" );
+
+    const size_t body_count = world.size();
+    if( !file || body_count > UINT32_MAX )
+        return;
+
+    const double *columns[trajectory_channel_count] = {
+        world.x.data(), world.y.data(), world.angle.data(),
+        world.vx.data(), world.vy.data(), world.w.data()
+    };
+
+    bool keyframe = !reference_valid ||
+        frames_since_keyframe >= options.keyframe_interval ||
+        reference.size() != body_count * trajectory_channel_count;
+
+    // klatka różnicowa tylko gdy wszystkie wartości da się skwantować
+    if( !keyframe )
+    {
+        quantized.resize( reference.size() );
+
+        for( int c = 0; c < trajectory_channel_count && !keyframe; c++ )
+        {
+            int64_t *q = quantized.data() + c * body_count;
+
+            for( size_t i = 0; i < body_count; i++ )
+            {
+                if( !trajectory_quantize( columns[c][i], inv_steps[c], q[i] ) )
+                {
+                    keyframe = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    TrajectoryChunkHeader chunk = {};
+    chunk.body_count = (uint32_t)body_count;
+    chunk.tick = tick;
+
+    const size_t chunk_start = block.size();
+    append_bytes( block, &chunk, 1 );
+
+    if( keyframe )
+    {
+        chunk.type = TrajectoryKeyframe;
+        index.push_back( TrajectoryIndexEntry{ tick, block_offset + chunk_start } );
+
+        for( int c = 0; c < trajectory_channel_count; c++ )
+            append_bytes( block, columns[c], body_count );
+
+        // wartości odniesienia dla następnych klatek różnicowych
+        reference.resize( body_count * trajectory_channel_count );
+        reference_valid = true;
+
+        for( int c = 0; c < trajectory_channel_count; c++ )
+        {
+            for( size_t i = 0; i < body_count; i++ )
+            {
+                if( !trajectory_quantize( columns[c][i], inv_steps[c],
+                        reference[c * body_count + i] ) )
+                    reference_valid = false;
+            }
+        }
+
+        frames_since_keyframe = 1;
+    }
+    else
+    {
+        chunk.type = TrajectoryDelta;
+
+        // miejsce na najdłuższe różnice, nadmiar jest potem obcinany
+        const size_t data_start = block.size();
+        block.resize( data_start + body_count * trajectory_channel_count * max_varint_size );
+        uint8_t *out = block.data() + data_start;
+
+        // różnice kanałów jednego obiektu są obok siebie
+        for( size_t i = 0; i < body_count; i++ )
+        {
+            for( int c = 0; c < trajectory_channel_count; c++ )
+            {
+                const size_t k = c * body_count + i;
+                out = write_varint( out, quantized[k] - reference[k] );
+            }
+        }
+
+        block.resize( out - block.data() );
+
+        reference.swap( quantized );
+        frames_since_keyframe++;
+    }
+
+    chunk.size = block.size() - chunk_start - sizeof(chunk);
+    memcpy( block.data() + chunk_start, &chunk, sizeof(chunk) );
+
+    last_tick = tick;
+    frames_in_block++;
+
+    if( block.size() >= options.block_size )
+        submit_block( false );
+}
+
+void TrajectoryRecorder::submit_block( bool force )
+{
+    if( block.empty() )
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+
+        if( force || pending.size() < options.max_pending_blocks )
+        {
+            block_offset += block.size();
+            pending.push_back( std::move( block ) );
+
+            block.clear();
+            if( !free_blocks.empty() )
+            {
+                block = std::move( free_blocks.back() );
+                free_blocks.pop_back();
+            }
+        }
+        else
+        {
+            // dysk nie nadąża - blok jest odrzucany, a następna klatka
+            // będzie kluczowa, bo klatki różnicowe odnosiłyby się do odrzuconych
+            dropped_frames += frames_in_block;
+            index.resize( block_index_size );
+            reference_valid = false;
+            block.clear();
+        }
+    }
+
+    pending_ready.notify_one();
+
+    if( block.capacity() < options.block_size )
+        block.reserve( options.block_size );
+
+    block_index_size = index.size();
+    frames_in_block = 0;
+}
+
+void TrajectoryRecorder::writer_loop()
+{
+    Profiler::set_thread_name( "trajectory writer" );
+
+    std::vector<std::vector<uint8_t>> writing;
+    writing.reserve( options.max_pending_blocks + 2 );
+
+    std::unique_lock<std::mutex> lock( mutex );
+
+    while( true )
+    {
+        pending_ready.wait( lock, [this] { return !pending.empty() || closing; } );
+
+        if( pending.empty() )
+            break;
+
+        writing.swap( pending );
+        lock.unlock();
+
+        for( const std::vector<uint8_t> &data : writing )
+        {
+            if( fwrite( data.data(), 1, data.size(), file ) != data.size() )
+                failed.store( true, std::memory_order_relaxed );
+        }
+
+        lock.lock();
+
+        for( std::vector<uint8_t> &data : writing )
+        {
+            data.clear();
+            free_blocks.push_back( std::move( data ) );
+        }
+        writing.clear();
+    }
+}
@@ -0,0 +1,130 @@
+/*
+Jakub Janeczko
+nagłówek zapisu trajektorii obiektów
+18.10.2026
+*/
+
+#pragma once
+
+#include "World.h"
+#include "Trajectory.h"
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * @brief ustawienia zapisu trajektorii
+ */
+struct TrajectoryOptions {
+    uint32_t keyframe_interval = 120; ///< co ile kroków zapisywana jest klatka kluczowa
+
+    double position_step = 1e-4; ///< krok kwantyzacji położenia [m]
+    double angle_step = 1e-5; ///< krok kwantyzacji kąta [rad]
+    double velocity_step = 1e-3; ///< krok kwantyzacji prędkości [m/s]
+    double angular_velocity_step = 1e-4; ///< krok kwantyzacji prędkości kątowej [rad/s]
+
+    size_t block_size = 1 << 20; ///< rozmiar bloku przekazywanego do zapisu [B]
+
+    /**
+     * @brief ile bloków może czekać na zapis - gdy dysk nie nadąża
+     *        kolejne klatki są pomijane zamiast zatrzymywać symulację
+     */
+    size_t max_pending_blocks = 64;
+};
+
+/**
+ * @brief zapisuje położenia i prędkości wszystkich obiektów po każdym
+ *        kroku symulacji do pliku trajektorii (zobacz Trajectory.h)
+ *
+ * record() jest wywoływane po onTick przez wątek symulacji - koduje klatkę
+ * do bloku w pamięci, a pełne bloki są zapisywane do pliku przez osobny
+ * wątek. Bloki są używane ponownie, więc w stanie ustalonym zapis nie alokuje
+ * pamięci. Klatka kluczowa jest zapisywana co keyframe_interval kroków,
+ * po zmianie liczby obiektów i po pominięciu klatek
+ */
+class TrajectoryRecorder {
+public:
+    /**
+     * @brief tworzy plik trajektorii i uruchamia wątek zapisujący
+     *
+     * gdy pliku nie udało się utworzyć is_ok() zwraca false
+     * a record() nic nie robi
+     */
+    explicit TrajectoryRecorder( const char *path,
+        const TrajectoryOptions &options = TrajectoryOptions{} );
+
+    /**
+     * @brief zamyka plik (zobacz close)
+     */
+    ~TrajectoryRecorder();
+
+    TrajectoryRecorder( const TrajectoryRecorder& ) = delete;
+    TrajectoryRecorder &operator=( const TrajectoryRecorder& ) = delete;
+
+    /**
+     * @brief zapisuje stan obiektów świata po kroku tick
+     *
+     * numery kroków kolejnych wywołań powinny rosnąć
+     */
+    void record( uint64_t tick, const World &world );
+
+    /**
+     * @brief czeka na zapis pozostałych klatek, zapisuje indeks i zamyka plik
+     *
+     * kolejne wywołania record() nic nie robią
+     *
+     * @return is_ok()
+     */
+    bool close();
+
+    /**
+     * @brief zwraca false jeżeli nie udało się utworzyć lub zapisać pliku
+     */
+    bool is_ok() const { return !failed.load( std::memory_order_relaxed ); }
+
+    /**
+     * @brief zwraca liczbę klatek pominiętych, bo dysk nie nadążał
+     */
+    uint64_t get_dropped_frames() const { return dropped_frames; }
+
+private:
+    TrajectoryOptions options;
+    double steps[trajectory_channel_count]; ///< kroki kwantyzacji kanałów
+    double inv_steps[trajectory_channel_count]; ///< odwrotności kroków kwantyzacji
+
+    FILE *file = nullptr;
+    std::atomic<bool> failed{ false };
+
+    // stan używany tylko przez wątek wywołujący record
+    std::vector<uint8_t> block; ///< kodowane klatki
+    uint64_t block_offset = 0; ///< położenie początku bloku w pliku [B]
+    size_t block_index_size = 0; ///< rozmiar indeksu na początku bloku
+    uint64_t frames_in_block = 0; ///< liczba klatek w bloku
+    std::vector<TrajectoryIndexEntry> index; ///< klatki kluczowe
+    uint64_t last_tick = 0; ///< ostatni zapisany krok
+
+    std::vector<int64_t> reference; ///< skwantowane wartości ostatniej klatki (kanałami)
+    std::vector<int64_t> quantized; ///< skwantowane wartości obecnej klatki
+    bool reference_valid = false; ///< czy następna klatka może być różnicowa
+    uint64_t frames_since_keyframe = 0;
+    uint64_t dropped_frames = 0;
+
+    // bloki wymieniane z wątkiem zapisującym, chronione przez mutex
+    std::mutex mutex;
+    std::condition_variable pending_ready;
+    std::vector<std::vector<uint8_t>> pending; ///< bloki czekające na zapis
+    std::vector<std::vector<uint8_t>> free_blocks; ///< zapisane bloki do ponownego użycia
+    bool closing = false;
+
+    std::thread writer;
+
+    // przekazuje blok do zapisu lub go odrzuca, gdy zbyt wiele bloków czeka
+    // (chyba że force)
+    void submit_block( bool force );
+    void writer_loop();
+};
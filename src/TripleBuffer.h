@@ -0,0 +1,67 @@
+/*
+Jakub Janeczko
+potrójny bufor do przekazywania danych pomiędzy wątkami
+18.10.2026
+*/
+
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+/**
+ * @brief potrójny bufor - jeden wątek zapisuje kolejne wartości,
+ *        a drugi czyta najnowszą z nich
+ * 
+ * producent zapisuje do back() i publikuje go przez publish(), konsument
+ * pobiera najnowszą opublikowaną wartość przez acquire(). Żaden z wątków
+ * nie czeka na drugi - wymieniają się jedynie indeksami buforów przez
+ * zmienną atomową, a każdy bufor w danej chwili należy do jednego wątku
+ * 
+ * @tparam T typ przekazywanej wartości
+ */
+template<class T>
+class TripleBuffer {
+public:
+    /**
+     * @brief zwraca bufor do zapisu przez producenta
+     * 
+     * zawiera wartość opublikowaną dwa razy wcześniej (lub starszą),
+     * więc można w nim ponownie wykorzystać zaalokowaną pamięć
+     */
+    T &back() { return buffers[back_index]; }
+
+    /**
+     * @brief publikuje zawartość back(), producent dostaje nowy bufor do zapisu
+     */
+    void publish()
+    {
+        const uint8_t old = middle.exchange( back_index | fresh_bit, std::memory_order_acq_rel );
+        back_index = old & index_mask;
+    }
+
+    /**
+     * @brief zwraca najnowszą opublikowaną wartość
+     * 
+     * referencja jest ważna do następnego wywołania acquire
+     */
+    const T &acquire()
+    {
+        if( middle.load( std::memory_order_relaxed ) & fresh_bit )
+        {
+            const uint8_t old = middle.exchange( front_index, std::memory_order_acq_rel );
+            front_index = old & index_mask;
+        }
+
+        return buffers[front_index];
+    }
+
+private:
+    static constexpr uint8_t index_mask = 3;
+    static constexpr uint8_t fresh_bit = 4; ///< środkowy bufor nie został jeszcze pobrany
+
+    T buffers[3];
+    uint8_t back_index = 0; ///< bufor producenta
+    std::atomic<uint8_t> middle{ 1 }; ///< bufor wymiany wraz z fresh_bit
+    uint8_t front_index = 2; ///< bufor konsumenta
+};
@@ -0,0 +1,91 @@
+/*
+Jakub Janeczko
+świat - zbiór symulowanych obiektów
+18.10.2026
+*/
+
+#include "World.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+uint32_t World::add( const PhysicsObject &obj )
+{
+    x.push_back( obj.center.x );
+    y.push_back( obj.center.y );
+    vx.push_back( obj.velocity.x );
+    vy.push_back( obj.velocity.y );
+    angle.push_back( obj.angle );
+    w.push_back( obj.ang_velocity );
+
+    inv_mass.push_back( obj.inv_mass );
+    inv_moment_of_intertia.push_back( obj.inv_moment_of_intertia );
+    flags.push_back( obj.flags );
+    sleep_time.push_back( obj.sleep_time );
+
+    shapes.push_back( obj.shape );
+    revision++;
+
+    return (uint32_t)( x.size() - 1 );
+}
+
+void World::remove( uint32_t body )
+{
+    x.erase( x.begin() + body );
+    y.erase( y.begin() + body );
+    vx.erase( vx.begin() + body );
+    vy.erase( vy.begin() + body );
+    angle.erase( angle.begin() + body );
+    w.erase( w.begin() + body );
+
+    inv_mass.erase( inv_mass.begin() + body );
+    inv_moment_of_intertia.erase( inv_moment_of_intertia.begin() + body );
+    flags.erase( flags.begin() + body );
+    sleep_time.erase( sleep_time.begin() + body );
+
+    shapes.erase( shapes.begin() + body );
+    revision++;
+}
+
+void World::clear()
+{
+    x.clear();
+    y.clear();
+    vx.clear();
+    vy.clear();
+    angle.clear();
+    w.clear();
+
+    inv_mass.clear();
+    inv_moment_of_intertia.clear();
+    flags.clear();
+    sleep_time.clear();
+
+    shapes.clear();
+    revision++;
+}
+
+void World::move_by( uint32_t body, const glm::dvec2 &vec, double d_angle )
+{
+    x[body] += vec.x;
+    y[body] += vec.y;
+    angle[body] += d_angle;
+}
+
+void World::wake_up( uint32_t body )
+{
+    flags[body] &= ~PhysicsObject::Sleeping;
+    sleep_time[body] = 0.0;
+}
+
+void World::add_impulse( uint32_t body,
+    const glm::dvec2 &point_of_application, const glm::dvec2 &value )
+{
+    if( flags[body] & PhysicsObject::Sleeping )
+        wake_up( body );
+
+    vx[body] += value.x * inv_mass[body];
+    vy[body] += value.y * inv_mass[body];
+    w[body] += vec_cross( point_of_application, value ) * inv_moment_of_intertia[body];
+}
@@ -0,0 +1,124 @@
+/*
+Jakub Janeczko
+nagłówek świata - zbioru symulowanych obiektów
+18.10.2026
+*/
+
+#pragma once
+
+#include "PhysicsObject.h"
+#include "Shape.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <stdint.h>
+
+/**
+ * @brief zbiór symulowanych obiektów
+ * 
+ * stan obiektów jest przechowywany w osobnych tablicach dla każdego pola
+ * (structure of arrays), więc pętle po jednym polu wszystkich obiektów
+ * (np. całkowanie prędkości) czytają tylko potrzebne dane i mogą zostać
+ * zwektoryzowane, a kształty obiektów są przechowywane osobno
+ * 
+ * obiekt jest identyfikowany indeksem 0..size()-1, który zmienia się
+ * jedynie przy usuwaniu obiektów o mniejszych indeksach
+ * 
+ * jednostki jak w PhysicsObject
+ */
+class World {
+public:
+    /**
+     * @brief dodaje obiekt na koniec świata
+     * 
+     * @return indeks dodanego obiektu
+     */
+    uint32_t add( const PhysicsObject &obj );
+
+    /**
+     * @brief usuwa obiekt, obiekty o większych indeksach zostają przesunięte
+     */
+    void remove( uint32_t body );
+
+    /**
+     * @brief usuwa wszystkie obiekty
+     */
+    void clear();
+
+    /**
+     * @brief zwraca liczbę obiektów
+     */
+    size_t size() const { return x.size(); }
+
+    /**
+     * @brief zwraca numer zmiany zbioru obiektów, rośnie przy każdym
+     *        dodaniu i usunięciu obiektu
+     */
+    uint64_t get_revision() const { return revision; }
+
+    std::vector<double> x; ///< pozycje x środków obiektów [m]
+    std::vector<double> y; ///< pozycje y środków obiektów [m]
+    std::vector<double> vx; ///< prędkości w osi x [m/s]
+    std::vector<double> vy; ///< prędkości w osi y [m/s]
+    std::vector<double> angle; ///< kąty obiektów [rad]
+    std::vector<double> w; ///< prędkości kątowe [rad/s]
+
+    std::vector<double> inv_mass; ///< odwrotności mas [1/kg]
+    std::vector<double> inv_moment_of_intertia; ///< odwrotności momentów bezwładności [1/(kg*m2)]
+    std::vector<uint32_t> flags; ///< opcje obiektów (zobacz PhysicsObject::FlagBits)
+    std::vector<double> sleep_time; ///< jak długo obiekty prawie się nie poruszają [s]
+
+    std::vector<Shape> shapes; ///< kształty obiektów
+
+    glm::dvec2 get_center( uint32_t body ) const { return { x[body], y[body] }; }
+    glm::dvec2 get_velocity( uint32_t body ) const { return { vx[body], vy[body] }; }
+
+    /**
+     * @brief przesuwa obiekt o zadany wektor i kąt
+     */
+    void move_by( uint32_t body, const glm::dvec2 &vec, double d_angle );
+
+    /**
+     * @brief zaaplikuj impuls do obiektu, budzi obiekt jeżeli jest uśpiony
+     * 
+     * @param point_of_application punkt przyłożenia siły względem środka [m]
+     * @param value impuls przyłożony [N * s]
+     */
+    void add_impulse( uint32_t body,
+        const glm::dvec2 &point_of_application, const glm::dvec2 &value );
+
+    /**
+     * @brief budzi uśpiony obiekt
+     */
+    void wake_up( uint32_t body );
+
+    /**
+     * @brief zwraca punkty obiektu obrócone o jego obecny kąt [m]
+     * 
+     * punkty są względem środka obiektu (zobacz Shape::get_points)
+     */
+    const std::vector<glm::dvec2> &get_points( uint32_t body ) const
+    {
+        return shapes[body].get_points( angle[body] );
+    }
+
+    /**
+     * @brief zwraca AABB obiektu w obecnej pozycji
+     */
+    AABB get_aabb( uint32_t body ) const
+    {
+        return shapes[body].get_aabb( get_center( body ), angle[body] );
+    }
+
+    /**
+     * @brief zwraca wielokąt obiektu w obecnej pozycji
+     */
+    Polygon get_polygon( uint32_t body ) const
+    {
+        return shapes[body].get_polygon( get_center( body ), angle[body] );
+    }
+
+private:
+    uint64_t revision = 0; ///< numer zmiany zbioru obiektów
+};
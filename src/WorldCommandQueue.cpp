@@ -0,0 +1,30 @@
+/*
+Jakub Janeczko
+kolejka zmian świata
+18.10.2026
+*/
+
+#include "WorldCommandQueue.h"
+
+#include <vector>
+#include <mutex>
+
+void WorldCommandQueue::push( Command command )
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    pending.push_back( std::move( command ) );
+}
+
+void WorldCommandQueue::execute( World &world )
+{
+    {
+        // zmiany są wykonywane poza blokadą, więc zlecanie nie czeka na ich wykonanie
+        std::lock_guard<std::mutex> lock( mutex );
+        executing.swap( pending );
+    }
+
+    for( Command &command : executing )
+        command( world );
+
+    executing.clear();
+}
@@ -0,0 +1,43 @@
+/*
+Jakub Janeczko
+nagłówek kolejki zmian świata
+18.10.2026
+*/
+
+#pragma once
+
+#include "World.h"
+
+#include <vector>
+#include <functional>
+#include <mutex>
+
+/**
+ * @brief kolejka zmian świata (dodanie, usunięcie obiektu, impuls...)
+ *        zlecanych przez inne wątki niż wątek symulacji
+ * 
+ * wątek symulacji wykonuje zlecone zmiany w kolejności zlecenia
+ * pomiędzy krokami symulacji
+ */
+class WorldCommandQueue {
+public:
+    using Command = std::function<void( World& )>;
+
+    /**
+     * @brief zleca zmianę świata, może być wywołane z dowolnego wątku
+     * 
+     * indeksy obiektów użyte w zmianie mogą być nieaktualne w chwili jej
+     * wykonania (np. po usunięciu obiektu), zmiana powinna to sprawdzić
+     */
+    void push( Command command );
+
+    /**
+     * @brief wykonuje wszystkie zlecone zmiany
+     */
+    void execute( World &world );
+
+private:
+    std::mutex mutex;
+    std::vector<Command> pending; ///< zlecone zmiany, chronione przez mutex
+    std::vector<Command> executing; ///< zmiany wykonywane w execute
+};
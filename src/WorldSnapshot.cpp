@@ -0,0 +1,48 @@
+/*
+Jakub Janeczko
+migawka stanu świata
+18.10.2026
+*/
+
+#include "WorldSnapshot.h"
+
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+
+void BodyPoses::assign( const World &world )
+{
+    x = world.x;
+    y = world.y;
+    angle = world.angle;
+}
+
+void WorldSnapshot::assign( const World &world, const BodyPoses &previous_poses,
+    std::shared_ptr<const std::vector<Shape>> world_shapes )
+{
+    x = world.x;
+    y = world.y;
+    vx = world.vx;
+    vy = world.vy;
+    angle = world.angle;
+    w = world.w;
+
+    inv_mass = world.inv_mass;
+    inv_moment_of_intertia = world.inv_moment_of_intertia;
+    flags = world.flags;
+    revision = world.get_revision();
+
+    shapes = std::move( world_shapes );
+    previous = previous_poses;
+}
+
+double WorldSnapshot::get_interpolation_factor(
+    std::chrono::steady_clock::time_point now ) const
+{
+    if( step_dt <= 0.0 )
+        return 1.0;
+
+    const double since_state = std::chrono::duration<double>( now - state_time ).count();
+    return std::clamp( since_state / step_dt, 0.0, 1.0 );
+}
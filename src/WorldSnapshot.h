@@ -0,0 +1,147 @@
+/*
+Jakub Janeczko
+nagłówek migawki stanu świata
+18.10.2026
+*/
+
+#pragma once
+
+#include "World.h"
+#include "Shape.h"
+#include "StepStats.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <stdint.h>
+
+/**
+ * @brief informacje o ostatnim kroku silnika fizyki
+ */
+struct EngineStatus {
+    size_t sleeping_count = 0; ///< liczba uśpionych obiektów
+    size_t color_count = 0; ///< liczba kolorów kontaktów w ostatnim podkroku
+    size_t min_pairs = 0; ///< najmniejsza liczba par szerokiej fazy w podkroku
+    size_t max_pairs = 0; ///< największa liczba par szerokiej fazy w podkroku
+    uint64_t tick_allocations = 0; ///< liczba alokacji pamięci w ostatnim kroku
+    StepStats stats; ///< liczniki pracy wykonanej w ostatnim kroku
+};
+
+/**
+ * @brief położenia i kąty wszystkich obiektów świata
+ */
+struct BodyPoses {
+    std::vector<double> x; ///< pozycje x środków obiektów [m]
+    std::vector<double> y; ///< pozycje y środków obiektów [m]
+    std::vector<double> angle; ///< kąty obiektów [rad]
+
+    /**
+     * @brief kopiuje położenia obiektów świata, w stanie ustalonym nie alokuje pamięci
+     */
+    void assign( const World &world );
+};
+
+/**
+ * @brief niezmienna kopia stanu świata po kroku symulacji
+ * 
+ * wątek symulacji zapisuje migawki po każdym kroku (zobacz PhysicsThread),
+ * a GUI i renderer czytają z nich zamiast ze świata. Kształty są współdzielone
+ * przez kolejne migawki i kopiowane tylko gdy zmieni się zbiór obiektów
+ * 
+ * kształty pamiętają ostatnio obrócone punkty, więc migawki z tymi samymi
+ * kształtami może czytać tylko jeden wątek
+ */
+class WorldSnapshot {
+public:
+    /**
+     * @brief kopiuje stan obiektów świata, w stanie ustalonym nie alokuje pamięci
+     * 
+     * @param previous_poses położenia obiektów przed ostatnim krokiem (te same indeksy)
+     * @param world_shapes kopia world.shapes
+     */
+    void assign( const World &world, const BodyPoses &previous_poses,
+        std::shared_ptr<const std::vector<Shape>> world_shapes );
+
+    size_t size() const { return x.size(); }
+
+    std::vector<double> x; ///< pozycje x środków obiektów [m]
+    std::vector<double> y; ///< pozycje y środków obiektów [m]
+    std::vector<double> vx; ///< prędkości w osi x [m/s]
+    std::vector<double> vy; ///< prędkości w osi y [m/s]
+    std::vector<double> angle; ///< kąty obiektów [rad]
+    std::vector<double> w; ///< prędkości kątowe [rad/s]
+
+    std::vector<double> inv_mass; ///< odwrotności mas [1/kg]
+    std::vector<double> inv_moment_of_intertia; ///< odwrotności momentów bezwładności [1/(kg*m2)]
+    std::vector<uint32_t> flags; ///< opcje obiektów (zobacz PhysicsObject::FlagBits)
+
+    std::shared_ptr<const std::vector<Shape>> shapes; ///< kształty obiektów
+
+    BodyPoses previous; ///< położenia obiektów przed ostatnim krokiem symulacji
+
+    uint64_t tick = 0; ///< numer kroku symulacji po którym wykonano migawkę
+    uint64_t revision = 0; ///< numer zmiany zbioru obiektów świata (World::get_revision)
+    double tick_time = 0.0; ///< czas obliczania kroku symulacji [s]
+    double step_dt = 0.0; ///< stały krok czasu symulacji [s]
+    std::chrono::steady_clock::time_point state_time; ///< chwila której odpowiada stan
+    EngineStatus status; ///< informacje o kroku silnika
+
+    const std::vector<Shape> &get_shapes() const { return *shapes; }
+
+    glm::dvec2 get_center( uint32_t body ) const { return { x[body], y[body] }; }
+    glm::dvec2 get_velocity( uint32_t body ) const { return { vx[body], vy[body] }; }
+
+    /**
+     * @brief zwraca współczynnik interpolacji pomiędzy stanem przed
+     *        ostatnim krokiem (0) a obecnym (1) do narysowania w chwili now
+     * 
+     * rysowany jest stan sprzed step_dt, więc ruch jest płynny niezależnie
+     * od tego ile kroków symulacji wykonano pomiędzy klatkami
+     */
+    double get_interpolation_factor( std::chrono::steady_clock::time_point now ) const;
+
+    /**
+     * @brief zwraca środek obiektu interpolowany pomiędzy dwoma ostatnimi stanami [m]
+     */
+    glm::dvec2 get_interpolated_center( uint32_t body, double alpha ) const
+    {
+        return {
+            previous.x[body] + ( x[body] - previous.x[body] ) * alpha,
+            previous.y[body] + ( y[body] - previous.y[body] ) * alpha
+        };
+    }
+
+    /**
+     * @brief zwraca kąt obiektu interpolowany pomiędzy dwoma ostatnimi stanami [rad]
+     */
+    double get_interpolated_angle( uint32_t body, double alpha ) const
+    {
+        return previous.angle[body] + ( angle[body] - previous.angle[body] ) * alpha;
+    }
+
+    /**
+     * @brief zwraca punkty obiektu obrócone o jego kąt [m]
+     */
+    const std::vector<glm::dvec2> &get_points( uint32_t body ) const
+    {
+        return get_shapes()[body].get_points( angle[body] );
+    }
+
+    /**
+     * @brief zwraca AABB obiektu
+     */
+    AABB get_aabb( uint32_t body ) const
+    {
+        return get_shapes()[body].get_aabb( get_center( body ), angle[body] );
+    }
+
+    /**
+     * @brief zwraca wielokąt obiektu
+     */
+    Polygon get_polygon( uint32_t body ) const
+    {
+        return get_shapes()[body].get_polygon( get_center( body ), angle[body] );
+    }
+};
@@ -5,58 +5,24 @@ pętla główna programu
 */
 
 #include "app.h"
-#include "PhysicsObject.h"
+#include "World.h"
+#include "Scene.h"
+#include "PhysicsThread.h"
+#include "AllocationCounter.h"
+#include "Profiler.h"
 
 #include <vector>
 #include <chrono>
 
 void App::run()
 {
-    const double
-        arena_width = 1000,
-        arena_height = 1000,
-        wall_thickness = 1000;
-    
-    const double a_hw = arena_width / 2.0, // arena half width
-                 a_h = arena_height,
-                 w_t = wall_thickness; 
+    World world = create_arena_scene();
 
-    std::vector<PhysicsObject> objs{
-        PhysicsObject(
-            {
-                {-a_hw, 0},
-                { a_hw, 0},
-                { a_hw, -w_t},
-                {-a_hw, -w_t}
-            }, 1.0, PhysicsObject::FlagBits::Immovable ),
-        PhysicsObject(
-            {
-                {-a_hw,       -w_t},
-                {-a_hw - w_t, -w_t},
-                {-a_hw,        a_h},
-                {-a_hw - w_t,  a_h}
-            }, 1.0, PhysicsObject::FlagBits::Immovable ),
-        PhysicsObject(
-            {
-                { a_hw,       -w_t},
-                { a_hw + w_t, -w_t},
-                { a_hw,        a_h},
-                { a_hw + w_t,  a_h}
-            }, 1.0, PhysicsObject::FlagBits::Immovable ),
-        PhysicsObject(
-            {
-                { a_hw + w_t,  a_h},
-                {-a_hw - w_t,  a_h},
-                { a_hw + w_t,  a_h + w_t},
-                {-a_hw - w_t,  a_h + w_t}
-            }, 1.0, PhysicsObject::FlagBits::Immovable ),
-        PhysicsObject(
-            {
-                {-10, 5},
-                { 10, 5},
-                { 0, 15}
-            }, 1.0, 0 ),
-    };
+    // alokacje GUI nie są liczone do alokacji kroku symulacji
+    count_thread_allocations( false );
+    Profiler::set_thread_name( "main" );
+
+    PhysicsThread physics( engine, std::move( world ) );
 
     using namespace std::chrono;
 
@@ -68,8 +34,7 @@ void App::run()
 
         double dt = duration<double>( cur_timestamp - last_timestamp ).count();
         
-        engine->onTick( objs, dt );
-        if( !gui.onDraw( objs, dt ) ) break;
+        if( !gui.onDraw( physics.get_snapshot(), physics.get_commands(), dt ) ) break;
 
         last_timestamp = cur_timestamp;
     }
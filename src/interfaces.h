@@ -6,7 +6,9 @@ definicje interfejsów
 
 #pragma once
 
-#include "PhysicsObject.h"
+#include "World.h"
+#include "WorldSnapshot.h"
+#include "WorldCommandQueue.h"
 
 #include <glm/glm.hpp>
 
@@ -17,6 +19,13 @@ definicje interfejsów
  */
 struct renderer_info {
     bool fill_objects; ///< czy obiekty powinny być wypełnione
+
+    /**
+     * @brief czy położenia obiektów są interpolowane pomiędzy
+     *        dwoma ostatnimi krokami symulacji
+     */
+    bool interpolate_objects = true;
+
     std::vector<glm::dvec2> additional_points; ///< dodatkowe punkty
     std::vector<glm::dvec2> additional_lines; ///< dodatkowe krawędzie
     std::vector<glm::dvec2> additional_triangles; ///< dodatkowe trójkąty
@@ -36,11 +45,13 @@ public:
     /**
      * @brief obsługuje interakcje z użytkownikiem i przygotowuje GUI do narysowania
      * 
-     * @param objs obiekty w symulacji
-     * @param dt różnica czasu od poprzedniego kroku symulacji
+     * @param world ostatni stan symulacji
+     * @param commands kolejka zmian świata wykonywanych przez wątek symulacji
+     * @param dt różnica czasu od poprzedniej klatki
      * @return renderer_info 
      */
-    virtual renderer_info handle_gui( std::vector<PhysicsObject> &objs, double dt ) = 0;
+    virtual renderer_info handle_gui( const WorldSnapshot &world,
+        WorldCommandQueue &commands, double dt ) = 0;
 };
 
 
@@ -54,13 +65,13 @@ public:
     /**
      * @brief rysuje GUI wraz z obiektami
      * 
-     * @param objs obiekty w symulacji
-     * @param dt różnica czasu od poprzedniego kroku symulacji
+     * @param world ostatni stan symulacji
+     * @param dt różnica czasu od poprzedniej klatki
      * @return true program powinien kontynuować działanie
      * @return false program powinien się zakończyć
      */
     virtual bool draw( const renderer_info &ri,
-        const std::vector<PhysicsObject> &objs, double dt ) = 0;
+        const WorldSnapshot &world, double dt ) = 0;
 };
 
 /**
@@ -73,8 +84,13 @@ public:
     /**
      * @brief oblicza stan symulacji po upływie dt czasu
      * 
-     * @param objs obiekty w symulacji
+     * @param world obiekty w symulacji
      * @param dt różnica czasu od poprzedniego kroku symulacji
      */
-    virtual void onTick( std::vector<PhysicsObject> &objs, double dt ) = 0;
+    virtual void onTick( World &world, double dt ) = 0;
+
+    /**
+     * @brief zwraca informacje o ostatnim kroku symulacji
+     */
+    virtual EngineStatus get_status() const { return EngineStatus{}; }
 };
\ No newline at end of file
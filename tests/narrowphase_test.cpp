@@ -0,0 +1,120 @@
+/*
+Jakub Janeczko
+test zgodności algorytmów wąskiej fazy na losowych otoczkach
+18.10.2026
+*/
+
+#include "PhysicsObject.h"
+#include "Narrowphase.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <random>
+#include <memory>
+#include <stdexcept>
+#include <stdio.h>
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+// przenikanie poniżej tej wartości może być wykryte tylko przez część
+// algorytmów z powodu zaokrągleń [m]
+constexpr double min_checked_depth = 1e-6;
+
+constexpr int pair_count = 50000;
+
+// otoczka losowej chmury 3-64 punktów w prostokącie o losowych proporcjach
+static std::unique_ptr<PhysicsObject> make_hull( std::mt19937 &rng )
+{
+    std::uniform_real_distribution<double> unit( -1.0, 1.0 );
+
+    const int point_count = 3 + (int)( rng() % 62 );
+    const double size_x = 0.2 + 0.9 * ( unit( rng ) + 1.0 );
+    const double size_y = size_x * ( 0.2 + 0.4 * ( unit( rng ) + 1.0 ) );
+
+    std::vector<glm::dvec2> points;
+    for( int i = 0; i < point_count; i++ )
+        points.push_back( glm::dvec2( unit( rng ) * size_x, unit( rng ) * size_y ) );
+
+    try
+    {
+        return std::make_unique<PhysicsObject>( points, 1.0 );
+    }
+    catch( const std::exception& )
+    {
+        // punkty współliniowe
+        return nullptr;
+    }
+}
+
+static double max_depth( const Manifold &manifold )
+{
+    double depth = 0.0;
+    for( int i = 0; i < manifold.count; i++ )
+        depth = std::max( depth, manifold.points[i].depth );
+
+    return depth;
+}
+
+int main()
+{
+    std::mt19937 rng( 2023 );
+    std::uniform_real_distribution<double> unit( -1.0, 1.0 );
+
+    const char *names[] = { "edge-point", "SAT", "GJK+EPA" };
+
+    int missed[3] = {};
+    int colliding = 0;
+
+    for( int pair = 0; pair < pair_count; )
+    {
+        std::unique_ptr<PhysicsObject> a = make_hull( rng ), b = make_hull( rng );
+        if( !a || !b ) continue;
+
+        a->move_by( glm::dvec2( 0.0 ), unit( rng ) * M_PI );
+        b->move_by( glm::dvec2( unit( rng ), unit( rng ) ) * 2.5, unit( rng ) * M_PI );
+
+        const Polygon pa = a->get_polygon(), pb = b->get_polygon();
+
+        Manifold manifolds[3];
+        SATCache cache;
+
+        const bool result[3] = {
+            collide_edge_point( pa, pb, manifolds[0] ),
+            collide_sat( pa, pb, cache, manifolds[1] ),
+            collide_gjk_epa( pa, pb, manifolds[2] )
+        };
+
+        // wyraźne przenikanie wykryte przez jeden algorytm muszą wykryć wszystkie
+        bool deep = false;
+        for( int i = 0; i < 3; i++ )
+            deep |= result[i] && max_depth( manifolds[i] ) > min_checked_depth;
+
+        if( deep )
+        {
+            colliding++;
+
+            for( int i = 0; i < 3; i++ )
+            {
+                if( result[i] ) continue;
+
+                if( missed[i]++ == 0 )
+                    printf( "%s: brak kontaktu dla pary %d\n", names[i], pair );
+            }
+        }
+
+        pair++;
+    }
+
+    printf( "par: %d, przenikających się: %d\n", pair_count, colliding );
+
+    bool ok = true;
+    for( int i = 0; i < 3; i++ )
+    {
+        printf( "%s: pominięte kontakty: %d\n", names[i], missed[i] );
+        ok &= missed[i] == 0;
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,190 @@
+/*
+Jakub Janeczko
+symulacja bez okna - mierzy przepustowość silnika fizyki
+18.10.2026
+*/
+
+#include "Simple_PhysicsEngine.h"
+#include "World.h"
+#include "Scene.h"
+#include "SceneFile.h"
+#include "TrajectoryRecorder.h"
+
+#include <memory>
+#include <chrono>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+static void print_usage( const char *program )
+{
+    fprintf( stderr,
+        "usage: %s [options]\n"
+        "  --bodies N        number of random polygons added to the arena (default 1000)\n"
+        "  --steps N         number of simulation steps (default 1000)\n"
+        "  --dt SECONDS      fixed time step (default 1/120)\n"
+        "  --threads N       engine threads, 0 = hardware threads (default 0)\n"
+        "  --broadphase NAME sap | tree | grid (default sap)\n"
+        "  --seed N          random scene seed (default 2023)\n"
+        "  --load FILE       load the scene from a scene file instead of random polygons\n"
+        "  --save FILE       save the scene to a scene file after the last step\n"
+        "  --record FILE     record body trajectories to a trajectory file\n"
+        "  --keyframe N      ticks between trajectory keyframes (default 120)\n",
+        program );
+}
+
+int main( int argc, char **argv )
+{
+    size_t bodies = 1000;
+    long steps = 1000;
+    double dt = 1.0 / 120.0;
+    unsigned threads = 0;
+    uint32_t seed = 2023;
+    const char *load_path = nullptr;
+    const char *save_path = nullptr;
+    const char *record_path = nullptr;
+    TrajectoryOptions record_options;
+    Simple_PhysicsEngine::BroadphaseType broadphase = Simple_PhysicsEngine::SweepAndPrune;
+
+    for( int i = 1; i < argc; i++ )
+    {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if( !value )
+        {
+            print_usage( argv[0] );
+            return 1;
+        }
+
+        if( !strcmp( arg, "--bodies" ) ) bodies = strtoull( value, nullptr, 10 );
+        else if( !strcmp( arg, "--steps" ) ) steps = strtol( value, nullptr, 10 );
+        else if( !strcmp( arg, "--dt" ) ) dt = strtod( value, nullptr );
+        else if( !strcmp( arg, "--threads" ) ) threads = (unsigned)strtoul( value, nullptr, 10 );
+        else if( !strcmp( arg, "--seed" ) ) seed = (uint32_t)strtoul( value, nullptr, 10 );
+        else if( !strcmp( arg, "--load" ) ) load_path = value;
+        else if( !strcmp( arg, "--save" ) ) save_path = value;
+        else if( !strcmp( arg, "--record" ) ) record_path = value;
+        else if( !strcmp( arg, "--keyframe" ) )
+            record_options.keyframe_interval = (uint32_t)strtoul( value, nullptr, 10 );
+        else if( !strcmp( arg, "--broadphase" ) )
+        {
+            if( !strcmp( value, "sap" ) ) broadphase = Simple_PhysicsEngine::SweepAndPrune;
+            else if( !strcmp( value, "tree" ) ) broadphase = Simple_PhysicsEngine::AABBTree;
+            else if( !strcmp( value, "grid" ) ) broadphase = Simple_PhysicsEngine::HashGrid;
+            else
+            {
+                print_usage( argv[0] );
+                return 1;
+            }
+        }
+        else
+        {
+            print_usage( argv[0] );
+            return 1;
+        }
+
+        i++;
+    }
+
+    if( steps <= 0 || dt <= 0.0 || record_options.keyframe_interval == 0 )
+    {
+        print_usage( argv[0] );
+        return 1;
+    }
+
+    using namespace std::chrono;
+
+    World world;
+
+    if( load_path )
+    {
+        const auto load_start = steady_clock::now();
+
+        if( !load_scene( load_path, world ) )
+        {
+            fprintf( stderr, "cannot load scene %s\n", load_path );
+            return 1;
+        }
+
+        printf( "loaded %s in %.3f ms\n", load_path,
+            duration<double, std::milli>( steady_clock::now() - load_start ).count() );
+    }
+    else
+    {
+        world = create_arena_scene();
+        add_random_polygons( world, bodies, seed );
+    }
+
+    Simple_PhysicsEngine engine;
+    engine.thread_count = threads;
+    engine.broadphase_type = broadphase;
+
+    printf( "bodies: %zu, steps: %ld, dt: %g s, threads: %u, simd: %s\n",
+        world.size(), steps, dt,
+        threads ? threads : JobSystem::get_hardware_threads(),
+        get_simd_level_name( engine.simd_level ) );
+
+    std::unique_ptr<TrajectoryRecorder> recorder;
+    if( record_path )
+    {
+        recorder = std::make_unique<TrajectoryRecorder>( record_path, record_options );
+        if( !recorder->is_ok() )
+        {
+            fprintf( stderr, "cannot create trajectory file %s\n", record_path );
+            return 1;
+        }
+
+        recorder->record( 0, world );
+    }
+
+    // czas zapisu trajektorii nie jest wliczany do przepustowości silnika
+    double record_seconds = 0.0;
+
+    const auto start = steady_clock::now();
+
+    for( long step = 0; step < steps; step++ )
+    {
+        engine.onTick( world, dt );
+
+        if( recorder )
+        {
+            const auto record_start = steady_clock::now();
+            recorder->record( (uint64_t)step + 1, world );
+            record_seconds += duration<double>( steady_clock::now() - record_start ).count();
+        }
+    }
+
+    const double seconds =
+        duration<double>( steady_clock::now() - start ).count() - record_seconds;
+    const double steps_per_second = steps / seconds;
+
+    printf( "time: %.3f s\n", seconds );
+    printf( "steps/s: %.1f\n", steps_per_second );
+    printf( "bodies*steps/s: %.4g\n", steps_per_second * world.size() );
+    printf( "sleeping bodies: %zu\n", engine.get_sleeping_count() );
+
+    if( recorder )
+    {
+        const auto close_start = steady_clock::now();
+        const bool closed = recorder->close();
+        const double close_seconds = duration<double>( steady_clock::now() - close_start ).count();
+
+        printf( "trajectory recording: %.3f s (%.3f ms/step), closing: %.3f s\n",
+            record_seconds, record_seconds * 1000.0 / steps, close_seconds );
+        printf( "dropped trajectory frames: %llu\n",
+            (unsigned long long)recorder->get_dropped_frames() );
+
+        if( !closed )
+        {
+            fprintf( stderr, "cannot write trajectory file %s\n", record_path );
+            return 1;
+        }
+    }
+
+    if( save_path && !save_scene( save_path, world ) )
+    {
+        fprintf( stderr, "cannot save scene %s\n", save_path );
+        return 1;
+    }
+}
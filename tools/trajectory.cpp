@@ -0,0 +1,110 @@
+/*
+Jakub Janeczko
+odczyt pliku trajektorii - podsumowanie i stan obiektów w wybranym kroku
+18.10.2026
+*/
+
+#include "TrajectoryReader.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+static void print_usage( const char *program )
+{
+    fprintf( stderr,
+        "usage: %s FILE [options]\n"
+        "  --tick N          print the state of all bodies at tick N as CSV\n"
+        "  --body N          print the trajectory of body N over all ticks as CSV\n",
+        program );
+}
+
+static void print_csv_header( const char *first_column )
+{
+    printf( "%s,x,y,angle,vx,vy,w\n", first_column );
+}
+
+static void print_csv_row( unsigned long long key, const TrajectoryFrame &frame, size_t body )
+{
+    printf( "%llu", key );
+    for( const std::vector<double> &channel : frame.channels )
+        printf( ",%.9g", channel[body] );
+    printf( "\n" );
+}
+
+int main( int argc, char **argv )
+{
+    if( argc < 2 || ( argc - 2 ) % 2 )
+    {
+        print_usage( argv[0] );
+        return 1;
+    }
+
+    const char *path = argv[1];
+    const char *tick = nullptr;
+    const char *body = nullptr;
+
+    for( int i = 2; i < argc; i += 2 )
+    {
+        if( !strcmp( argv[i], "--tick" ) ) tick = argv[i + 1];
+        else if( !strcmp( argv[i], "--body" ) ) body = argv[i + 1];
+        else
+        {
+            print_usage( argv[0] );
+            return 1;
+        }
+    }
+
+    TrajectoryReader reader;
+    if( !reader.open( path ) )
+    {
+        fprintf( stderr, "cannot open trajectory file %s\n", path );
+        return 1;
+    }
+
+    if( tick )
+    {
+        const uint64_t t = strtoull( tick, nullptr, 10 );
+        if( !reader.seek( t ) )
+        {
+            fprintf( stderr, "tick %llu is not in %s\n", (unsigned long long)t, path );
+            return 1;
+        }
+
+        const TrajectoryFrame &frame = reader.get_frame();
+
+        print_csv_header( "body" );
+        for( size_t i = 0; i < frame.size(); i++ )
+            print_csv_row( i, frame, i );
+
+        return 0;
+    }
+
+    if( body )
+    {
+        const size_t b = strtoull( body, nullptr, 10 );
+
+        print_csv_header( "tick" );
+        while( reader.next() )
+        {
+            const TrajectoryFrame &frame = reader.get_frame();
+            if( b < frame.size() )
+                print_csv_row( frame.tick, frame, b );
+        }
+
+        return 0;
+    }
+
+    const TrajectoryFileHeader &header = reader.get_header();
+    const std::vector<TrajectoryIndexEntry> &keyframes = reader.get_keyframes();
+
+    printf( "keyframe interval: %u ticks\n", header.keyframe_interval );
+    printf( "quantization: position %g m, angle %g rad, velocity %g m/s, angular velocity %g rad/s\n",
+        header.step[0], header.step[2], header.step[3], header.step[5] );
+    printf( "keyframes: %zu\n", keyframes.size() );
+
+    if( !keyframes.empty() )
+        printf( "ticks: %llu - %llu\n",
+            (unsigned long long)keyframes.front().tick,
+            (unsigned long long)reader.get_last_tick() );
+}